@@ -1,19 +1,506 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <exception>
 #include <iostream>
+#include <mutex>
+#include <memory>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 
+#include "common/input_view.h"
+
 
 constexpr int kAdd = 1;
 constexpr int kMultiply = 2;
 constexpr int kTerminate = 99;
 
+// Computed goto is a GCC/Clang extension; everything else gets the switch.
+// Build with -DINTCODE_COMPUTED_GOTO=0 to force the portable fallback.
+#ifndef INTCODE_COMPUTED_GOTO
+#if defined(__GNUC__) || defined(__clang__)
+#define INTCODE_COMPUTED_GOTO 1
+#else
+#define INTCODE_COMPUTED_GOTO 0
+#endif
+#endif
+
+// The native tier emits x86-64 code for the System V calling convention.
+// Build with -DINTCODE_JIT=0 to leave it out.
+#ifndef INTCODE_JIT
+#if defined(__x86_64__) && defined(__unix__)
+#define INTCODE_JIT 1
+#else
+#define INTCODE_JIT 0
+#endif
+#endif
+
+#if INTCODE_JIT
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+// Operations in the pre-decoded instruction stream. These index the dispatch
+// table in InterpretThreaded(), so the order matters. The IntoCode variants
+// write into code that has been decoded but not yet executed, and are the only
+// ones that need to check whether the stream has to be re-decoded.
+enum DecodedOp {
+    kOpAdd = 0,
+    kOpMultiply = 1,
+    kOpAddIntoCode = 2,
+    kOpMultiplyIntoCode = 3,
+    kOpTerminate = 4,
+    kOpIllegal = 5,
+};
+
+struct DecodedInstruction {
+    // Label address for direct-threaded dispatch (unused by the switch fallback).
+    const void* handler;
+    DecodedOp op;
+    int l;
+    int r;
+    int dest;
+    // Address of the opcode in memory, used for error reporting and for
+    // working out where to resume after a write into not-yet-executed code.
+    int position;
+};
+
+
+typedef std::shared_ptr<const std::vector<int>> MemoryImage;
+
+
+// Copy-on-write view of a shared, immutable memory image. Any number of views
+// can share one image, and nothing is copied or allocated until the first
+// write: until then, reads go straight to the image. The first write copies
+// the image into one contiguous buffer owned by this view, so every read and
+// write is a single access either way. Writes are tracked a page at a time so
+// that Reset() only has to copy back the pages the last run dirtied, and the
+// buffer is kept from one run to the next.
+class PagedMemory {
+    public:
+        static constexpr int kPageBits = 6;
+        static constexpr int kPageSize = 1 << kPageBits;
+
+        explicit PagedMemory(MemoryImage image) {
+            Reset(std::move(image));
+        }
+
+        int size() const {
+            return size_;
+        }
+
+        int num_pages() const {
+            return num_pages_;
+        }
+
+        const MemoryImage& image() const {
+            return image_;
+        }
+
+        // The pages written since the last Reset(), in the order they were
+        // first written.
+        const std::vector<int>& dirty_pages() const {
+            return dirty_pages_;
+        }
+
+        bool IsDirty(int page) const {
+            return !dirty_.empty() && dirty_[page];
+        }
+
+        int operator[](int address) const {
+            return cells_[address];
+        }
+
+        void Write(int address, int value) {
+            const int page = address >> kPageBits;
+            if (!IsDirty(page)) {
+                MarkDirty(page);
+            }
+            private_[address] = value;
+        }
+
+        // The whole of memory, valid until the next write or Reset().
+        const int* data() const {
+            return cells_;
+        }
+
+        void CopyTo(std::vector<int>& out, int count) const {
+            out.resize(count);
+            std::memcpy(out.data(), cells_, count * sizeof(int));
+        }
+
+        // Marks the listed pages (or every page, if 'pages' is null) as
+        // written and returns the buffer for writing to them directly, valid
+        // until the next Reset(image).
+        int* WritablePages(const std::vector<int>* pages) {
+            if (pages == nullptr) {
+                for (int page = 0; page < num_pages_; page++) {
+                    if (!IsDirty(page)) {
+                        MarkDirty(page);
+                    }
+                }
+            } else {
+                for (int page : *pages) {
+                    if (!IsDirty(page)) {
+                        MarkDirty(page);
+                    }
+                }
+            }
+            MakePrivate();
+            return private_.data();
+        }
+
+        // Throws away all writes. Only dirty pages are copied back, and the
+        // buffer is kept so the next run doesn't allocate.
+        void Reset() {
+            for (int page : dirty_pages_) {
+                const int page_start = page * kPageSize;
+                const int n = std::min(kPageSize, size_ - page_start);
+                std::memcpy(private_.data() + page_start, image_->data() + page_start, n * sizeof(int));
+                dirty_[page] = false;
+            }
+            dirty_pages_.clear();
+        }
+
+        // Throws away all writes and switches to a different image.
+        void Reset(MemoryImage image) {
+            image_ = std::move(image);
+            size_ = image_->size();
+            num_pages_ = (size_ + kPageSize - 1) / kPageSize;
+            cells_ = image_->data();
+            private_.clear();
+            dirty_.clear();
+            dirty_pages_.clear();
+        }
+
+    private:
+        MemoryImage image_;
+        int size_ = 0;
+        int num_pages_ = 0;
+        // Where to read from: the image until the first write, then private_.
+        const int* cells_ = nullptr;
+        // Our copy of memory once written. Its clean pages match the image.
+        std::vector<int> private_;
+        // Whether each page has been written since the last Reset(). Empty
+        // until the first write.
+        std::vector<char> dirty_;
+        std::vector<int> dirty_pages_;
+
+        void MakePrivate() {
+            if (private_.empty()) {
+                private_.assign(image_->begin(), image_->end());
+                dirty_.assign(num_pages_, false);
+                cells_ = private_.data();
+            }
+        }
+
+        void MarkDirty(int page) {
+            MakePrivate();
+            dirty_[page] = true;
+            dirty_pages_.push_back(page);
+        }
+};
+
+#if INTCODE_JIT
+
+// Native x86-64 code for the straight-line add/multiply prefix of a program,
+// operating directly on the interpreter's memory. The code is specialised on the operand
+// addresses it was compiled against; operand cells that are seen to change
+// between runs (such as the noun and verb) are recompiled as loads from
+// memory instead, so a sweep settles after a single recompile.
+//
+// Running the trace returns the address the interpreter should carry on
+// from: a terminate instruction when the whole program ran natively, or the
+// first instruction the trace couldn't handle. That is anything other than
+// add or multiply, an out-of-range address (so the interpreter raises the
+// error), or the instruction after a write into code that hasn't run yet.
+class NativeTrace {
+    public:
+        NativeTrace() = default;
+        NativeTrace(const NativeTrace&) = delete;
+        NativeTrace& operator=(const NativeTrace&) = delete;
+
+        ~NativeTrace() {
+            if (buffer_ != nullptr) {
+                munmap(buffer_, capacity_);
+            }
+        }
+
+        bool compiled() const {
+            return compiled_;
+        }
+
+        // Whether the compiled code is still valid for 'memory', given that
+        // only the listed cells can have changed since it was compiled. Any
+        // operand cell found to have changed is remembered as variable.
+        bool MatchesCells(const int* memory, std::initializer_list<int> addresses) {
+            bool matches = true;
+            for (int address : addresses) {
+                matches &= MatchesCell(memory, address);
+            }
+            return matches;
+        }
+
+        // As MatchesCells(), for every cell on the listed pages.
+        bool MatchesPages(const int* memory, const std::vector<int>& pages) {
+            bool matches = true;
+            for (int page : pages) {
+                const int page_start = page * PagedMemory::kPageSize;
+                const int page_end = std::min(page_start + PagedMemory::kPageSize, code_limit_ + 1);
+                for (int address = page_start; address < page_end; address++) {
+                    matches &= MatchesCell(memory, address);
+                }
+            }
+            return matches;
+        }
+
+        // Pages the code can write to, or null if it writes through variable
+        // addresses and so could write anywhere.
+        const std::vector<int>* written_pages() const {
+            return writes_anywhere_ ? nullptr : &written_pages_;
+        }
+
+        void Compile(const int* cells, int size) {
+            if (static_cast<int>(variable_.size()) != size) {
+                variable_.assign(size, false);
+            }
+            compiled_image_.assign(cells, cells + size);
+            const std::vector<int>& memory = compiled_image_;
+            written_pages_.clear();
+            writes_anywhere_ = false;
+
+            // Find the extent of the straight-line code, so writes into the
+            // part of it that hasn't run yet can be spotted.
+            int stop = 0;
+            while (stop + 3 < size && (memory[stop] == kAdd || memory[stop] == kMultiply)) {
+                stop += 4;
+            }
+            if (stop < size && memory[stop] == kTerminate) {
+                code_limit_ = stop;
+            } else {
+                // Fixing the operands of an illegal instruction could make it legal.
+                code_limit_ = std::min(stop + 3, size - 1);
+            }
+
+            code_.clear();
+            int pos = 0;
+            while (pos < stop && EmitInstruction(memory, pos)) {
+                pos += 4;
+            }
+            if (pos == stop) {
+                EmitExit(pos);
+            }
+
+            std::sort(written_pages_.begin(), written_pages_.end());
+            written_pages_.erase(std::unique(written_pages_.begin(), written_pages_.end()), written_pages_.end());
+
+            Install();
+            compiled_ = true;
+        }
+
+        int Run(int* memory) const {
+            return reinterpret_cast<int (*)(int*)>(buffer_)(memory);
+        }
+
+    private:
+        std::vector<unsigned char> code_;
+        unsigned char* buffer_ = nullptr;
+        size_t capacity_ = 0;
+        bool compiled_ = false;
+        std::vector<int> compiled_image_;
+        std::vector<char> variable_;
+        // Last address of the straight-line code (inclusive).
+        int code_limit_ = 0;
+        std::vector<int> written_pages_;
+        bool writes_anywhere_ = false;
+
+        bool MatchesCell(const int* memory, int address) {
+            if (address > code_limit_ || memory[address] == compiled_image_[address] || variable_[address]) {
+                return true;
+            }
+            variable_[address] = address % 4 != 0;
+            return false;
+        }
+
+        void Emit(std::initializer_list<unsigned char> bytes) {
+            code_.insert(code_.end(), bytes);
+        }
+
+        void Emit32(int value) {
+            for (int i = 0; i < 4; i++) {
+                code_.push_back(static_cast<unsigned char>(static_cast<unsigned int>(value) >> (8 * i)));
+            }
+        }
+
+        // mov eax, position; ret
+        void EmitExit(int position) {
+            Emit({0xB8});
+            Emit32(position);
+            Emit({0xC3});
+        }
+
+        // Loads the address held in 'cell' into ecx, leaving the trace at
+        // 'position' if it's out of range.
+        void EmitLoadAddress(int cell, int size, int position) {
+            Emit({0x8B, 0x8F});  // mov ecx, [rdi + cell * 4]
+            Emit32(cell * 4);
+            Emit({0x81, 0xF9});  // cmp ecx, size
+            Emit32(size);
+            Emit({0x72, 0x06});  // jb past the exit
+            EmitExit(position);
+        }
+
+        // Emits one add/multiply at 'pos', returning false if the trace ends
+        // here (in which case the exit has been emitted).
+        bool EmitInstruction(const std::vector<int>& memory, int pos) {
+            const int size = memory.size();
+            const bool multiply = memory[pos] == kMultiply;
+
+            for (int operand = 1; operand <= 3; operand++) {
+                const int value = memory[pos + operand];
+                if (!variable_[pos + operand] && (value < 0 || value >= size)) {
+                    EmitExit(pos);
+                    return false;
+                }
+            }
+
+            // eax = memory[l]
+            if (variable_[pos + 1]) {
+                EmitLoadAddress(pos + 1, size, pos);
+                Emit({0x8B, 0x04, 0x8F});  // mov eax, [rdi + rcx * 4]
+            } else {
+                Emit({0x8B, 0x87});  // mov eax, [rdi + l * 4]
+                Emit32(memory[pos + 1] * 4);
+            }
+
+            // eax op= memory[r]
+            if (variable_[pos + 2]) {
+                EmitLoadAddress(pos + 2, size, pos);
+                if (multiply) {
+                    Emit({0x0F, 0xAF, 0x04, 0x8F});  // imul eax, [rdi + rcx * 4]
+                } else {
+                    Emit({0x03, 0x04, 0x8F});  // add eax, [rdi + rcx * 4]
+                }
+            } else {
+                if (multiply) {
+                    Emit({0x0F, 0xAF, 0x87});  // imul eax, [rdi + r * 4]
+                } else {
+                    Emit({0x03, 0x87});  // add eax, [rdi + r * 4]
+                }
+                Emit32(memory[pos + 2] * 4);
+            }
+
+            // memory[dest] = eax, leaving the trace if that rewrote code ahead.
+            const int next = pos + 4;
+            if (variable_[pos + 3]) {
+                EmitLoadAddress(pos + 3, size, pos);
+                Emit({0x89, 0x04, 0x8F});  // mov [rdi + rcx * 4], eax
+                writes_anywhere_ = true;
+                if (next <= code_limit_) {
+                    Emit({0x8D, 0x91});  // lea edx, [rcx - next]
+                    Emit32(-next);
+                    Emit({0x81, 0xFA});  // cmp edx, number of cells ahead
+                    Emit32(code_limit_ - next + 1);
+                    Emit({0x73, 0x06});  // jae past the exit
+                    EmitExit(next);
+                }
+            } else {
+                const int dest = memory[pos + 3];
+                Emit({0x89, 0x87});  // mov [rdi + dest * 4], eax
+                Emit32(dest * 4);
+                written_pages_.push_back(dest >> PagedMemory::kPageBits);
+                if (dest >= next && dest <= code_limit_) {
+                    EmitExit(next);
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // Copies the code into an executable buffer, growing it if needed.
+        // The buffer is never writable and executable at the same time.
+        void Install() {
+            if (code_.size() > capacity_) {
+                if (buffer_ != nullptr) {
+                    munmap(buffer_, capacity_);
+                }
+                const size_t page_size = sysconf(_SC_PAGESIZE);
+                capacity_ = (code_.size() + page_size - 1) / page_size * page_size;
+                void* buffer = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (buffer == MAP_FAILED) {
+                    buffer_ = nullptr;
+                    capacity_ = 0;
+                    throw std::runtime_error("Couldn't map memory for native code");
+                }
+                buffer_ = static_cast<unsigned char*>(buffer);
+            } else if (mprotect(buffer_, capacity_, PROT_READ | PROT_WRITE) != 0) {
+                throw std::runtime_error("Couldn't make native code writable");
+            }
+
+            std::memcpy(buffer_, code_.data(), code_.size());
+            if (mprotect(buffer_, capacity_, PROT_READ | PROT_EXEC) != 0) {
+                throw std::runtime_error("Couldn't make native code executable");
+            }
+        }
+};
+
+#endif
+
+
+// Built out of line so the interpreter loops stay small enough to inline.
+std::runtime_error CreateIllegalOperatorException(int position, int value) {
+    std::stringstream stream;
+    stream << "Illegal operator at position " << position << ": " << value;
+    return std::runtime_error(stream.str());
+}
+
+std::runtime_error CreateRanOffEndException(int position) {
+    std::stringstream stream;
+    stream << "Program counter ran off the end of memory at position " << position;
+    return std::runtime_error(stream.str());
+}
+
 
 class Interpreter {
     public:
-        Interpreter(std::vector<int> input): memory_(input) {}
+        Interpreter(std::vector<int> input): Interpreter(std::make_shared<const std::vector<int>>(std::move(input))) {}
+
+        // Runs against a shared image, which isn't copied until the first
+        // write.
+        explicit Interpreter(MemoryImage image): memory_(std::move(image)) {}
+
+        // Restores the original image, so a single interpreter can be reused
+        // across many runs at the cost of only the pages the last run dirtied.
+        void Reset() {
+            memory_.Reset();
+            progc_ = 0;
+            inputs_only_ = true;
+        }
+
+        // Switches to a different program image.
+        void Reset(MemoryImage image) {
+            memory_.Reset(std::move(image));
+            progc_ = 0;
+            inputs_only_ = true;
+        }
+
+        // Sets the two puzzle inputs, which live at addresses 1 and 2.
+        void SetNounAndVerb(int noun, int verb) {
+            if (memory_.size() < 3) {
+                throw std::out_of_range("Program too short to take a noun and verb");
+            }
+            memory_.Write(1, noun);
+            memory_.Write(2, verb);
+        }
 
         int Interpret() {
+            inputs_only_ = false;
             while (memory_[progc_] != kTerminate) {
                 InterpretInstruction();
             }
@@ -21,9 +508,149 @@ class Interpreter {
             return memory_[0];
         }
 
+        // Equivalent to Interpret(), but runs the program as native code where
+        // possible and hands over to InterpretThreaded() wherever the native
+        // trace stops. Programs whose code keeps changing between runs give up
+        // on native code after a few recompiles. Without JIT support this is
+        // just InterpretThreaded().
+        int InterpretNative() {
+#if INTCODE_JIT
+            constexpr int kMaxNativeCompiles = 8;
+
+            if (progc_ == 0 && native_compiles_ <= kMaxNativeCompiles) {
+                if (!native_) {
+                    native_ = std::make_unique<NativeTrace>();
+                }
+                if (!NativeTraceMatches()) {
+                    ++native_compiles_;
+                    native_->Compile(memory_.data(), memory_.size());
+                    native_image_ = memory_.image();
+                    // The code depends on these pages differing from the image.
+                    native_compiled_pages_ = memory_.dirty_pages();
+                    native_inputs_only_ = inputs_only_;
+                }
+
+                inputs_only_ = false;
+                progc_ = native_->Run(memory_.WritablePages(native_->written_pages()));
+
+                if (progc_ < memory_.size() && memory_[progc_] == kTerminate) {
+                    return memory_[0];
+                }
+            }
+#endif
+            return InterpretThreaded();
+        }
+
+        // Equivalent to Interpret(), but runs a pre-decoded instruction stream
+        // with direct-threaded dispatch. The stream is kept across Reset()s, so
+        // re-running a program with a few cells changed (e.g. a noun/verb sweep)
+        // only re-decodes the instructions that changed. Writes into code that
+        // hasn't run yet cause the rest of the program to be re-decoded, so
+        // self-modifying programs behave identically. Which instructions can do
+        // that is worked out while decoding, so the others don't check.
+        int InterpretThreaded() {
+#if INTCODE_COMPUTED_GOTO
+            static const void* const kDispatch[] = {
+                &&do_add, &&do_multiply, &&do_add_into_code, &&do_multiply_into_code,
+                &&do_terminate, &&do_illegal};
+#else
+            static const void* const* const kDispatch = nullptr;
+#endif
+            PrepareStream(kDispatch);
+            decoded_inputs_only_ = inputs_only_;
+            inputs_only_ = false;
+            const DecodedInstruction* ins = stream_.data();
+
+#if INTCODE_COMPUTED_GOTO
+#define INTCODE_DISPATCH() goto *ins->handler
+#define INTCODE_CASE(label, op) label:
+#else
+#define INTCODE_DISPATCH() goto dispatch
+#define INTCODE_CASE(label, op) case op:
+#endif
+
+// Re-decodes everything after the current instruction, which has just
+// written into it.
+#define INTCODE_REDECODE()                                                      \
+            do {                                                                \
+                int index = ins - stream_.data() + 1;                           \
+                Decode(index, ins->position + 4, kDispatch);                    \
+                ins = stream_.data() + index;                                   \
+                stream_reusable_ = false;                                       \
+            } while (false)
+
+#if INTCODE_COMPUTED_GOTO
+            INTCODE_DISPATCH();
+#else
+        dispatch:
+            switch (ins->op) {
+#endif
+
+            INTCODE_CASE(do_add, kOpAdd)
+                memory_.Write(ins->dest, memory_[ins->l] + memory_[ins->r]);
+                ++ins;
+                INTCODE_DISPATCH();
+
+            INTCODE_CASE(do_multiply, kOpMultiply)
+                memory_.Write(ins->dest, memory_[ins->l] * memory_[ins->r]);
+                ++ins;
+                INTCODE_DISPATCH();
+
+            INTCODE_CASE(do_add_into_code, kOpAddIntoCode)
+                memory_.Write(ins->dest, memory_[ins->l] + memory_[ins->r]);
+                INTCODE_REDECODE();
+                INTCODE_DISPATCH();
+
+            INTCODE_CASE(do_multiply_into_code, kOpMultiplyIntoCode)
+                memory_.Write(ins->dest, memory_[ins->l] * memory_[ins->r]);
+                INTCODE_REDECODE();
+                INTCODE_DISPATCH();
+
+            INTCODE_CASE(do_illegal, kOpIllegal)
+                if (ins->position < memory_.size()) {
+                    throw CreateIllegalOperatorException(ins->position, memory_[ins->position]);
+                }
+                throw CreateRanOffEndException(ins->position);
+
+            INTCODE_CASE(do_terminate, kOpTerminate)
+                progc_ = ins->position;
+                return memory_[0];
+
+#if !INTCODE_COMPUTED_GOTO
+            }
+            // Unreachable: every DecodedOp is handled above.
+            return memory_[0];
+#endif
+
+#undef INTCODE_REDECODE
+#undef INTCODE_CASE
+#undef INTCODE_DISPATCH
+        }
+
     private:
         int progc_ = 0;
-        std::vector<int> memory_;
+        PagedMemory memory_;
+        // Decoded form of the code starting at address 0, reused between runs.
+        std::vector<DecodedInstruction> stream_;
+        // Copy of memory_[0, decoded end) as it was when stream_ was decoded,
+        // and the image it was decoded over.
+        std::vector<int> decoded_image_;
+        MemoryImage decoded_from_;
+        bool stream_reusable_ = false;
+        // Whether memory has only been changed by SetNounAndVerb() since the
+        // last Reset(), and whether that was also true when the decoded image
+        // was last brought up to date.
+        bool inputs_only_ = true;
+        bool decoded_inputs_only_ = false;
+#if INTCODE_JIT
+        std::unique_ptr<NativeTrace> native_;
+        int native_compiles_ = 0;
+        // The image the trace was compiled over, the pages on which memory
+        // differed from it then, and whether only the noun and verb did.
+        MemoryImage native_image_;
+        std::vector<int> native_compiled_pages_;
+        bool native_inputs_only_ = false;
+#endif
 
         int ConsumeInt() {
             int result = memory_[progc_];
@@ -35,36 +662,590 @@ class Interpreter {
             int l = ConsumeInt();
             int r = ConsumeInt();
             int dest = ConsumeInt();
-            memory_[dest] = memory_[l] + memory_[r];
+            memory_.Write(dest, memory_[l] + memory_[r]);
         }
 
         void DoMultiply() {
             int l = ConsumeInt();
             int r = ConsumeInt();
             int dest = ConsumeInt();
-            memory_[dest] = memory_[l] * memory_[r];
+            memory_.Write(dest, memory_[l] * memory_[r]);
         }
 
         void InterpretInstruction() {
             int instruction = ConsumeInt();
             switch (instruction) {
-                case kAdd: 
+                case kAdd:
                     DoAdd();
                     break;
                 case kMultiply:
                     DoMultiply();
                     break;
-                default: {
-                    std::stringstream stream;
-                    stream << "Illegal operator at position " << progc_-1 << ": " << memory_[progc_];
-                    throw std::runtime_error(stream.str());
+                default:
+                    throw CreateIllegalOperatorException(progc_-1, memory_[progc_]);
+            }
+        }
+
+#if INTCODE_JIT
+        // Whether the native trace is still valid for memory_. As for the
+        // threaded stream, in a sweep only the noun and verb can differ from
+        // what it was compiled against; otherwise the pages dirty now or when
+        // it was compiled are compared.
+        bool NativeTraceMatches() {
+            if (!native_->compiled() || native_image_ != memory_.image()) {
+                return false;
+            }
+            if (inputs_only_ && native_inputs_only_) {
+                return native_->MatchesCells(memory_.data(), {1, 2});
+            }
+            // Both are checked so every changed operand is seen.
+            const bool compiled_pages_match = native_->MatchesPages(memory_.data(), native_compiled_pages_);
+            const bool dirty_pages_match = native_->MatchesPages(memory_.data(), memory_.dirty_pages());
+            return compiled_pages_match && dirty_pages_match;
+        }
+#endif
+
+        bool IsAddress(int value) const {
+            return value >= 0 && value < memory_.size();
+        }
+
+        // Decodes straight-line code starting at address 'from' into stream_,
+        // replacing everything from stream_[index] onwards. Decoding stops at
+        // the first terminate or undecodable instruction, which is emitted as
+        // kOpIllegal so the error is only raised if it's actually reached.
+        // Returns the address just past the last cell the stream depends on.
+        int Decode(int index, int from, const void* const* dispatch) {
+            const int size = memory_.size();
+            stream_.resize(index);
+            int pos = from;
+            int end;
+
+            for (;;) {
+                DecodedInstruction ins {nullptr, kOpIllegal, 0, 0, 0, pos};
+
+                if (pos < size && memory_[pos] == kTerminate) {
+                    ins.op = kOpTerminate;
+                } else if (pos + 3 < size
+                           && (memory_[pos] == kAdd || memory_[pos] == kMultiply)
+                           && IsAddress(memory_[pos + 1])
+                           && IsAddress(memory_[pos + 2])
+                           && IsAddress(memory_[pos + 3])) {
+                    ins.op = memory_[pos] == kAdd ? kOpAdd : kOpMultiply;
+                    ins.l = memory_[pos + 1];
+                    ins.r = memory_[pos + 2];
+                    ins.dest = memory_[pos + 3];
+                }
+                stream_.push_back(ins);
+
+                if (ins.op == kOpTerminate) {
+                    end = pos + 1;
+                    break;
+                }
+                if (ins.op == kOpIllegal) {
+                    // Fixing any of the operands could make this decodable.
+                    end = std::min(pos + 4, size);
+                    break;
+                }
+                pos += 4;
+            }
+
+            for (int i = index; i < static_cast<int>(stream_.size()); i++) {
+                Link(stream_[i], end, dispatch);
+            }
+            return end;
+        }
+
+        // Picks the handler for an instruction now that the end of the decoded
+        // code is known, using the IntoCode variant if it writes past itself
+        // into that code.
+        static void Link(DecodedInstruction& ins, int decoded_end, const void* const* dispatch) {
+            const bool into_code = ins.dest >= ins.position + 4 && ins.dest < decoded_end;
+            switch (ins.op) {
+                case kOpAdd:
+                case kOpAddIntoCode:
+                    ins.op = into_code ? kOpAddIntoCode : kOpAdd;
+                    break;
+                case kOpMultiply:
+                case kOpMultiplyIntoCode:
+                    ins.op = into_code ? kOpMultiplyIntoCode : kOpMultiply;
+                    break;
+                case kOpTerminate:
+                case kOpIllegal:
+                    break;
+            }
+            if (dispatch != nullptr) {
+                ins.handler = dispatch[ins.op];
+            }
+        }
+
+        // Updates stream_ for one cell that differs from the decoded image,
+        // returning false if that meant re-decoding the tail of the program
+        // (which takes care of every later cell too).
+        bool PatchCell(int address, int end, const void* const* dispatch) {
+            const int value = memory_[address];
+
+            const int index = address / 4;
+            DecodedInstruction& ins = stream_[index];
+            const int operand = address % 4;
+            const bool is_arithmetic = ins.op != kOpTerminate && ins.op != kOpIllegal;
+
+            if (operand == 0 || !is_arithmetic || !IsAddress(value)) {
+                memory_.CopyTo(decoded_image_, Decode(index, ins.position, dispatch));
+                return false;
+            }
+
+            switch (operand) {
+                case 1: ins.l = value; break;
+                case 2: ins.r = value; break;
+                case 3:
+                    ins.dest = value;
+                    Link(ins, end, dispatch);
+                    break;
+            }
+            decoded_image_[address] = value;
+            return true;
+        }
+
+        // Brings stream_ up to date with memory_ ready to run from progc_. In a
+        // sweep, the stream was decoded from the image plus a noun and verb,
+        // and memory is that image plus a new noun and verb, so only those two
+        // cells are compared: a changed operand is patched in place, and a
+        // changed opcode forces the tail of the program to be re-decoded.
+        // Anything else (a different image, or memory left over from an
+        // earlier run) is decoded from scratch.
+        void PrepareStream(const void* const* dispatch) {
+            if (progc_ != 0 || !stream_reusable_ || decoded_from_ != memory_.image()
+                || !inputs_only_ || !decoded_inputs_only_) {
+                const int end = Decode(0, progc_, dispatch);
+                stream_reusable_ = progc_ == 0;
+                decoded_from_ = memory_.image();
+                memory_.CopyTo(decoded_image_, end);
+                return;
+            }
+
+            const int end = decoded_image_.size();
+            for (int address : {1, 2}) {
+                if (address < end && memory_[address] != decoded_image_[address]
+                    && !PatchCell(address, end, dispatch)) {
+                    return;
                 }
             }
         }
 };
 
 
-int main() {
+struct NounAndVerb {
+    int noun;
+    int verb;
+};
+
+// Searches every (noun, verb) pair in [0, max_value]^2 for one that makes the
+// program produce 'target', splitting the candidates between 'num_threads'
+// workers. All workers share one image of the program; each reuses a single
+// interpreter, which copies it once and then only restores the pages each run
+// wrote to. All workers stop as soon as any of them finds an answer; if
+// several pairs work, which one is returned is unspecified.
+// Throws if the program is too short to take a noun and verb, or if a worker
+// fails for any reason other than a candidate turning the program to garbage.
+std::optional<NounAndVerb> FindNounAndVerb(
+    const std::vector<int>& program, int target, int max_value = 99,
+    int num_threads = std::thread::hardware_concurrency()) {
+    // Candidates are handed out in chunks so workers rarely contend on the counter.
+    constexpr int kChunkSize = 64;
+    const int num_candidates = (max_value + 1) * (max_value + 1);
+    std::atomic<int> next_candidate = 0;
+    std::atomic<bool> found = false;
+    NounAndVerb answer {};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    if (program.size() < 3) {
+        throw std::runtime_error("Program too short to take a noun and verb");
+    }
+    const auto image = std::make_shared<const std::vector<int>>(program);
+
+    auto search = [&]() {
+        Interpreter interpreter(image);
+
+        while (!found.load(std::memory_order_relaxed)) {
+            const int start = next_candidate.fetch_add(kChunkSize, std::memory_order_relaxed);
+            if (start >= num_candidates) {
+                return;
+            }
+            const int end = std::min(start + kChunkSize, num_candidates);
+
+            for (int candidate = start; candidate < end && !found.load(std::memory_order_relaxed); candidate++) {
+                const int noun = candidate / (max_value + 1);
+                const int verb = candidate % (max_value + 1);
+                interpreter.Reset();
+                interpreter.SetNounAndVerb(noun, verb);
+
+                int result;
+                try {
+                    result = interpreter.InterpretNative();
+                } catch (const std::runtime_error&) {
+                    // Some inputs turn the program into garbage; they just aren't the answer.
+                    continue;
+                }
+
+                if (result == target && !found.exchange(true)) {
+                    answer = {noun, verb};
+                    return;
+                }
+            }
+        }
+    };
+
+    // Nothing may escape a std::thread, so the first failure is kept to be
+    // rethrown once all the workers have stopped.
+    auto worker = [&]() {
+        try {
+            search();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            found = true;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < std::max(num_threads, 1); i++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (!found) {
+        return {};
+    }
+    return answer;
+}
+
+// Reads a comma-separated program, which may be split over several lines.
+std::vector<int> ParseProgramFile(const std::string& file_path) {
+    std::vector<int> result;
+    InputView input(file_path);
+    LineReader lines(input.contents());
+    std::string_view line;
+
+    while (lines.Next(line)) {
+        FieldReader values(line, ',');
+        std::string_view value;
+        while (values.Next(value)) {
+            result.push_back(ParseInt(value));
+        }
+    }
+
+    return result;
+}
+
+
+// Builds a deterministic straight-line program of 'length' instructions that
+// reads from a block of small constants and accumulates into scratch cells,
+// finally writing its result to address 0.
+std::vector<int> MakeBenchmarkProgram(int length) {
+    const int code_size = length * 4 + 1;
+    const int constants = code_size;
+    const int num_constants = 16;
+    const int scratch = constants + num_constants;
+    const int num_scratch = 8;
+
+    std::vector<int> program(scratch + num_scratch, 0);
+    unsigned int seed = 12345;
+    auto next = [&seed](int bound) {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<int>((seed >> 16) % bound);
+    };
+
+    for (int i = 0; i < length; i++) {
+        bool last = i == length - 1;
+        program[i * 4] = next(2) == 0 ? kAdd : kMultiply;
+        program[i * 4 + 1] = constants + next(num_constants);
+        program[i * 4 + 2] = constants + next(num_constants);
+        program[i * 4 + 3] = last ? 0 : scratch + next(num_scratch);
+    }
+    program[code_size - 1] = kTerminate;
+
+    for (int i = 0; i < num_constants; i++) {
+        program[constants + i] = i % 10;
+    }
+
+    return program;
+}
+
+// Builds a program shaped like a real day 2 input: a short preamble, then a
+// chain of 30 instructions each folding a small constant into the previous
+// result, ending with the answer in address 0. The noun and verb are read as
+// addresses, so any value below 100 is valid.
+std::vector<int> MakeGravityAssistProgram() {
+    std::vector<int> program = {1, 0, 0, 3, 1, 1, 2, 3, 1, 3, 4, 3, 1, 5, 0, 3};
+    const int constants[] = {5, 6, 9, 10, 13};
+    unsigned int seed = 2019;
+    auto next = [&seed](int bound) {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<int>((seed >> 16) % bound);
+    };
+
+    int previous = 1;
+    for (int i = 0; i < 30; i++) {
+        // Multiplying only every fifth step keeps the result well inside an int.
+        const int position = program.size();
+        program.insert(program.end(), {i % 5 == 0 ? kMultiply : kAdd, previous,
+                                       constants[next(5)], position + 3});
+        previous = position + 3;
+    }
+    program.insert(program.end(), {kAdd, previous, 2, 0, kTerminate, kMultiply, 0, 14, 0});
+
+    return program;
+}
+
+template <typename Run>
+double TimePerRunNanos(const std::vector<int>& program, const std::vector<NounAndVerb>& inputs,
+                       int iterations, Run run) {
+    // Like a noun/verb sweep, each run resets memory and changes the inputs.
+    Interpreter interpreter(program);
+    auto start = std::chrono::steady_clock::now();
+    long long checksum = 0;
+    for (int i = 0; i < iterations; i++) {
+        const NounAndVerb& input = inputs[i % inputs.size()];
+        interpreter.Reset();
+        interpreter.SetNounAndVerb(input.noun, input.verb);
+        checksum += run(interpreter);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Stop the compiler discarding the runs.
+    volatile long long sink = checksum;
+    (void)sink;
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+// Builds a random straight-line program which Interpret() can run safely:
+// every operand is an in-range address, and the only writes into code put an
+// in-range address into an operand of a later instruction, so the program
+// modifies itself without ever becoming malformed.
+std::vector<int> MakeSelfModifyingProgram(unsigned int seed) {
+    auto next = [&seed](int bound) {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<int>((seed >> 16) % bound);
+    };
+
+    const int length = 1 + next(40);
+    const int code_size = length * 4 + 1;
+    const int zero = code_size;
+    const int constants = zero + 1;
+    const int num_constants = 8;
+    const int scratch = constants + num_constants;
+    const int num_scratch = 4;
+    const int size = scratch + num_scratch;
+
+    // Some instructions copy a constant into an input operand of a later,
+    // ordinary instruction. The first and last instructions are never copies,
+    // so the noun and verb and the final result behave as usual.
+    std::vector<bool> copies(length, false);
+    for (int i = 1; i + 1 < length; i++) {
+        copies[i] = next(4) == 0;
+    }
+
+    std::vector<int> program(size, 0);
+    for (int i = 0; i < length; i++) {
+        const int pos = i * 4;
+        program[pos] = next(2) == 0 ? kAdd : kMultiply;
+        program[pos + 1] = constants + next(num_constants);
+        program[pos + 2] = constants + next(num_constants);
+        program[pos + 3] = i + 1 == length ? 0 : scratch + next(num_scratch);
+
+        if (copies[i]) {
+            const int target = i + 1 + next(length - i - 1);
+            if (!copies[target]) {
+                program[pos] = kAdd;
+                program[pos + 2] = zero;
+                program[pos + 3] = target * 4 + 1 + next(2);
+            }
+        }
+    }
+    program[code_size - 1] = kTerminate;
+    for (int i = 0; i < num_constants; i++) {
+        program[constants + i] = next(size);
+    }
+
+    return program;
+}
+
+// Checks InterpretThreaded() and InterpretNative() against Interpret() on
+// many random programs and noun/verb inputs, reusing the same interpreters
+// across runs like a sweep would. Every other program is padded out with
+// zeros to several pages, so Reset() has clean pages to leave alone as well
+// as dirty ones to restore.
+void RunDifferentialTest() {
+    constexpr int kPrograms = 2000;
+    constexpr int kRunsPerProgram = 16;
+    constexpr int kPaddedSize = 5 * PagedMemory::kPageSize;
+    int runs = 0;
+
+    for (unsigned int seed = 1; seed <= kPrograms; seed++) {
+        std::vector<int> program = MakeSelfModifyingProgram(seed);
+        if (seed % 2 == 0) {
+            program.resize(std::max<int>(program.size(), kPaddedSize));
+        }
+        const auto image = std::make_shared<const std::vector<int>>(std::move(program));
+        const int size = image->size();
+        Interpreter threaded(image);
+        Interpreter native(image);
+
+        for (int run = 0; run < kRunsPerProgram; run++) {
+            // Keep the first instruction's operands fixed on some runs, so
+            // both the specialised and the variable code paths get exercised.
+            const int noun = run < kRunsPerProgram / 2 ? (*image)[1] : (seed * 7 + run * 13) % size;
+            const int verb = run < kRunsPerProgram / 2 ? (*image)[2] : (seed * 11 + run * 5) % size;
+
+            Interpreter reference(image);
+            reference.SetNounAndVerb(noun, verb);
+            const int expected = reference.Interpret();
+
+            threaded.Reset();
+            threaded.SetNounAndVerb(noun, verb);
+            native.Reset();
+            native.SetNounAndVerb(noun, verb);
+            const int threaded_result = threaded.InterpretThreaded();
+            const int native_result = native.InterpretNative();
+
+            if (threaded_result != expected || native_result != expected) {
+                std::stringstream stream;
+                stream << "Program " << seed << " with noun " << noun << " and verb " << verb
+                       << ": Interpret() gave " << expected << ", InterpretThreaded() gave " << threaded_result
+                       << ", InterpretNative() gave " << native_result;
+                throw std::runtime_error(stream.str());
+            }
+            ++runs;
+        }
+    }
+
+    std::cout << "All engines agree on " << runs << " runs of " << kPrograms << " programs." << std::endl;
+}
+
+void RunBenchmark() {
+    const std::vector<std::vector<int>> samples = {
+        {1, 9, 10, 3, 2, 3, 11, 0, 99, 30, 40, 50},
+        {1, 0, 0, 0, 99},
+        {2, 3, 0, 3, 99},
+        {2, 4, 4, 5, 99, 0},
+        {1, 1, 1, 4, 99, 5, 6, 0, 99},
+    };
+
+    for (const auto& sample : samples) {
+        int expected = Interpreter(sample).Interpret();
+        int threaded = Interpreter(sample).InterpretThreaded();
+        int native = Interpreter(sample).InterpretNative();
+        if (expected != threaded || expected != native) {
+            std::stringstream stream;
+            stream << "Threaded result " << threaded << " or native result " << native
+                   << " differs from interpreted result " << expected;
+            throw std::runtime_error(stream.str());
+        }
+    }
+
+    std::cout << "Dispatch: " << (INTCODE_COMPUTED_GOTO ? "computed goto" : "switch")
+              << ", native tier: " << (INTCODE_JIT ? "x86-64" : "unavailable") << std::endl;
+    auto print_row = [](const std::string& label, const std::vector<int>& program,
+                        const std::vector<NounAndVerb>& inputs, int iterations) {
+        double switch_ns = TimePerRunNanos(
+            program, inputs, iterations, [](Interpreter& interpreter) { return interpreter.Interpret(); });
+        double threaded_ns = TimePerRunNanos(
+            program, inputs, iterations, [](Interpreter& interpreter) { return interpreter.InterpretThreaded(); });
+        double native_ns = TimePerRunNanos(
+            program, inputs, iterations, [](Interpreter& interpreter) { return interpreter.InterpretNative(); });
+        std::cout << label << ": Interpret() " << switch_ns << " ns/run, InterpretThreaded() "
+                  << threaded_ns << " ns/run, InterpretNative() " << native_ns << " ns/run" << std::endl;
+    };
+
+    for (int length : {4, 32, 256}) {
+        const auto program = MakeBenchmarkProgram(length);
+        // The first instruction's own operands make valid inputs.
+        std::vector<NounAndVerb> inputs;
+        for (int variant = 0; variant < 4; variant++) {
+            inputs.push_back({program[1 + variant * 4], program[2 + variant * 4]});
+        }
+        print_row(std::to_string(length) + " instructions", program, inputs, 2000000 / length);
+    }
+
+    std::vector<NounAndVerb> sweep;
+    for (int noun = 0; noun < 100; noun += 7) {
+        for (int verb = 0; verb < 100; verb += 11) {
+            sweep.push_back({noun, verb});
+        }
+    }
+    const auto gravity_assist = MakeGravityAssistProgram();
+    print_row("Day 2 program (" + std::to_string(gravity_assist.size()) + " cells)",
+              gravity_assist, sweep, 200000);
+
+    // Starting an interpreter on a shared image should cost about the same
+    // regardless of program size, unlike copying the program in.
+    for (int length : {32, 1024}) {
+        const auto program = MakeBenchmarkProgram(length);
+        const auto image = std::make_shared<const std::vector<int>>(program);
+        const int iterations = 100000;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            Interpreter interpreter(program);
+        }
+        auto copied = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            Interpreter interpreter(image);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << length << " instructions: start from copy "
+                  << std::chrono::duration<double, std::nano>(copied - start).count() / iterations
+                  << " ns, from shared image "
+                  << std::chrono::duration<double, std::nano>(end - copied).count() / iterations
+                  << " ns" << std::endl;
+    }
+}
+
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        RunBenchmark();
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--verify") {
+        RunDifferentialTest();
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--search") {
+        if (argc < 4) {
+            std::cout << "Usage: " << argv[0] << " --search <target> <program file>";
+            return 1;
+        }
+        std::optional<NounAndVerb> answer;
+        try {
+            const auto program = ParseProgramFile(argv[3]);
+            answer = FindNounAndVerb(program, ParseInt(argv[2]));
+        } catch (const std::exception& e) {
+            std::cout << "Search failed: " << e.what();
+            return 1;
+        }
+        if (!answer.has_value()) {
+            std::cout << "No noun and verb produce the target!";
+            return 1;
+        }
+        std::cout << "Noun: " << answer->noun << ", verb: " << answer->verb
+                  << ". Result: " << 100 * answer->noun + answer->verb;
+        return 0;
+    }
+
     std::vector<int> input = {1,1,1,4,99,5,6,0,99};
     Interpreter interpreter(input);
     std::cout << "Result: " << interpreter.Interpret();
@@ -1,55 +1,51 @@
-#include <algorithm>
-#include <exception>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
-namespace {
+#include "expense_report.h"
 
-constexpr int kTarget = 2020;
 
-std::vector<int> ParseNumberListFile(std::string file_path) {
-    std::vector<int> result;
-    std::ifstream infile(file_path);
-    int value;
-
-    while (infile >> value) {
-        result.push_back(value);
-    }
-
-    return result;
-}
-
-int FindAnswer(std::vector<int> numbers, int target) {
-    std::sort(numbers.begin(), numbers.end());
-
-    int l = 0;
-    int r = numbers.size() - 1;
-
-    for (int sum = 0; sum != target; sum = numbers[l] + numbers[r]) {
-        if (sum > target) {
-            r--;
+int main(int argc, char* argv[]) {
+    // With --stream the file is read a chunk at a time and only until the pair
+    // turns up, rather than all loaded first. A file name of '-' reads stdin.
+    bool stream = false;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--stream") {
+            stream = true;
         } else {
-            l++;
-        }
-        // Check the indexes haven't crossed.
-        if (l >= r) {
-            throw std::runtime_error("No matching pair of numbers found!");
+            positional.push_back(argv[i]);
         }
     }
 
-    return numbers[l] * numbers[r];
-}
-
-}
-
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
+    if (positional.empty()) {
         std::cout << "Must pass a file name to parse!";
         return 1;
     }
 
-    std::vector<int> numbers = ParseNumberListFile(std::string(argv[1]));
-    std::cout << "Result: " << FindAnswer(numbers, kTarget);
+    // The expenses should sum to 2020 unless another target is given.
+    long long target = positional.size() > 1 ? std::stoll(positional[1]) : day01::kExpenseTarget;
+
+    if (stream) {
+        std::ifstream infile;
+        if (positional[0] != "-") {
+            infile.open(positional[0], std::ios::binary);
+            if (!infile) {
+                std::cout << "Couldn't open input file '" << positional[0] << "'!";
+                return 1;
+            }
+        }
+        auto pair = day01::FindPairInStream(positional[0] == "-" ? std::cin : infile, target);
+        if (!pair) {
+            std::cout << "No matching pair of numbers found!";
+            return 1;
+        }
+        std::cout << "Result: " << static_cast<long long>(pair->first) * pair->second;
+        return 0;
+    }
+
+    std::vector<int> numbers = day01::ParseNumberListFile(positional[0]);
+    std::cout << "Result: " << day01::FindPairProduct(numbers, target);
 }
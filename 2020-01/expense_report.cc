@@ -0,0 +1,306 @@
+#include "expense_report.h"
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <istream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day01 {
+
+namespace {
+
+// A set of values. Those in [bitmap_min, bitmap_max] are kept in a bitmap and
+// any others in an open-addressing hash table that grows as needed. Clear()
+// only resets what was written since the last clear, so one set can be reused
+// for every search.
+class ValueSet {
+  public:
+    ValueSet(long long bitmap_min, long long bitmap_max, size_t expected_size)
+        : bitmap_min_(bitmap_min), bitmap_max_(bitmap_max) {
+        if (bitmap_min <= bitmap_max) {
+            bitmap_.resize((static_cast<unsigned long long>(bitmap_max - bitmap_min) + 64) / 64);
+        }
+        Resize(expected_size);
+    }
+
+    bool Contains(long long value) const {
+        if (InBitmap(value)) {
+            unsigned long long offset = value - bitmap_min_;
+            return (bitmap_[offset / 64] >> (offset % 64)) & 1;
+        }
+        if (table_size_ == 0) return false;
+        for (size_t slot = Hash(value);; slot = NextSlot(slot)) {
+            if (slots_[slot] == value) return true;
+            if (slots_[slot] == kEmpty) return false;
+        }
+    }
+
+    void Insert(long long value) {
+        if (InBitmap(value)) {
+            unsigned long long offset = value - bitmap_min_;
+            uint64_t& word = bitmap_[offset / 64];
+            if (word == 0) touched_words_.push_back(offset / 64);
+            word |= 1ULL << (offset % 64);
+            return;
+        }
+        if (2 * (table_size_ + 1) > slots_.size()) {
+            Resize(table_size_ + 1);
+        }
+        size_t slot = Hash(value);
+        while (slots_[slot] != kEmpty) {
+            if (slots_[slot] == value) return;
+            slot = NextSlot(slot);
+        }
+        slots_[slot] = value;
+        touched_slots_.push_back(slot);
+        ++table_size_;
+    }
+
+    void Clear() {
+        for (size_t word : touched_words_) {
+            bitmap_[word] = 0;
+        }
+        for (size_t slot : touched_slots_) {
+            slots_[slot] = kEmpty;
+        }
+        touched_words_.clear();
+        touched_slots_.clear();
+        table_size_ = 0;
+    }
+
+  private:
+    static constexpr long long kEmpty = LLONG_MIN;
+
+    bool InBitmap(long long value) const {
+        return value >= bitmap_min_ && value <= bitmap_max_;
+    }
+
+    size_t Hash(long long value) const {
+        return (static_cast<uint64_t>(value) * 0x9E3779B97F4A7C15ULL) >> shift_;
+    }
+
+    size_t NextSlot(size_t slot) const {
+        return (slot + 1) & (slots_.size() - 1);
+    }
+
+    // Makes room for 'size' values in the table, keeping those already there.
+    void Resize(size_t size) {
+        size_t capacity = 16;
+        while (capacity < 2 * size) capacity *= 2;
+        if (capacity <= slots_.size()) return;
+
+        std::vector<long long> old_slots(capacity, kEmpty);
+        old_slots.swap(slots_);
+        shift_ = 64;
+        for (size_t remaining = capacity; remaining > 1; remaining /= 2) {
+            --shift_;
+        }
+
+        touched_slots_.clear();
+        table_size_ = 0;
+        for (long long value : old_slots) {
+            if (value != kEmpty) Insert(value);
+        }
+    }
+
+    long long bitmap_min_;
+    long long bitmap_max_;
+    std::vector<uint64_t> bitmap_;
+    std::vector<long long> slots_;
+    size_t table_size_ = 0;
+    int shift_ = 64;
+    // Bitmap words and table slots written since the last Clear().
+    std::vector<size_t> touched_words_;
+    std::vector<size_t> touched_slots_;
+};
+
+// Reads whitespace-separated integers from a stream a chunk at a time, so only
+// the current chunk is ever held in memory.
+class NumberStream {
+  public:
+    explicit NumberStream(std::istream& input) : input_(input), buffer_(kChunkSize) {}
+
+    bool Next(int& value) {
+        while (true) {
+            while (begin_ < end_ && std::isspace(static_cast<unsigned char>(buffer_[begin_]))) {
+                ++begin_;
+            }
+
+            size_t token_end = begin_;
+            while (token_end < end_ && !std::isspace(static_cast<unsigned char>(buffer_[token_end]))) {
+                ++token_end;
+            }
+
+            // A token running up to the end of the chunk may continue in the next one.
+            if (token_end == end_ && !at_eof_) {
+                Refill();
+                continue;
+            }
+            if (begin_ == token_end) {
+                return false;
+            }
+
+            value = ParseInt(std::string_view(buffer_.data() + begin_, token_end - begin_));
+            begin_ = token_end;
+            return true;
+        }
+    }
+
+  private:
+    static constexpr size_t kChunkSize = 1 << 16;
+
+    // Moves the unread part of the buffer to the front and reads more after it.
+    void Refill() {
+        std::copy(buffer_.begin() + begin_, buffer_.begin() + end_, buffer_.begin());
+        end_ -= begin_;
+        begin_ = 0;
+        if (end_ == buffer_.size()) {
+            buffer_.resize(2 * buffer_.size());
+        }
+
+        input_.read(buffer_.data() + end_, buffer_.size() - end_);
+        if (input_.gcount() == 0) {
+            at_eof_ = true;
+        }
+        end_ += input_.gcount();
+    }
+
+    std::istream& input_;
+    std::vector<char> buffer_;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+    bool at_eof_ = false;
+};
+
+// Looks for 'k' entries from numbers[begin..] summing to 'target', appending
+// their values to 'found'.
+bool FindEntriesFrom(const std::vector<int>& numbers, size_t begin, int k, long long target,
+                     ValueSet* seen, std::vector<int>* found) {
+    if (k == 1) {
+        if (std::find(numbers.begin() + begin, numbers.end(), target) == numbers.end()) return false;
+        found->push_back(target);
+        return true;
+    }
+
+    if (k == 2) {
+        seen->Clear();
+        for (size_t i = begin; i < numbers.size(); ++i) {
+            long long complement = target - numbers[i];
+            if (seen->Contains(complement)) {
+                found->push_back(complement);
+                found->push_back(numbers[i]);
+                return true;
+            }
+            seen->Insert(numbers[i]);
+        }
+        return false;
+    }
+
+    for (size_t i = begin; i + k <= numbers.size(); ++i) {
+        found->push_back(numbers[i]);
+        if (FindEntriesFrom(numbers, i + 1, k - 1, target - numbers[i], seen, found)) return true;
+        found->pop_back();
+    }
+    return false;
+}
+
+long long MultiplyEntriesWithSum(const std::vector<int>& numbers, int k, long long target) {
+    std::optional<std::vector<int>> entries = FindEntriesWithSum(numbers, k, target);
+    if (!entries) {
+        std::stringstream msg;
+        msg << "No " << k << " numbers found summing to " << target << "!";
+        throw std::runtime_error(msg.str());
+    }
+
+    long long product = 1;
+    for (int entry : *entries) {
+        product *= entry;
+    }
+    return product;
+}
+
+}
+
+std::vector<int> ParseNumberList(std::string_view input) {
+    std::vector<int> result;
+    Scanner scanner(input);
+    int value;
+
+    while (scanner.NextInt(value)) {
+        result.push_back(value);
+    }
+
+    return result;
+}
+
+std::vector<int> ParseNumberListFile(const std::string& file_path) {
+    InputView input(file_path);
+    return ParseNumberList(input.contents());
+}
+
+std::optional<std::vector<int>> FindEntriesWithSum(const std::vector<int>& numbers, int k, long long target) {
+    if (k < 1 || static_cast<size_t>(k) > numbers.size()) return {};
+
+    // No more than k copies of a value can be used, so for anything beyond
+    // pairs the extra copies are dropped up front. Long lists of values from a
+    // small range leave far fewer entries to fix in turn.
+    std::vector<int> capped;
+    if (k > 2) {
+        capped = numbers;
+        std::sort(capped.begin(), capped.end());
+        size_t kept = 0;
+        for (int value : capped) {
+            if (kept < static_cast<size_t>(k) || capped[kept - k] != value) {
+                capped[kept++] = value;
+            }
+        }
+        capped.resize(kept);
+    }
+    const std::vector<int>& candidates = k > 2 ? capped : numbers;
+
+    // Bitmaps only pay off when the values are reasonably dense.
+    const auto [min_value, max_value] = std::minmax_element(candidates.begin(), candidates.end());
+    unsigned long long range = static_cast<long long>(*max_value) - *min_value + 1;
+    bool dense = range <= std::max<unsigned long long>(64 * candidates.size(), 1 << 20);
+    ValueSet seen = dense ? ValueSet(*min_value, *max_value, 0) : ValueSet(1, 0, candidates.size());
+    std::vector<int> found;
+    if (!FindEntriesFrom(candidates, 0, k, target, &seen, &found)) return {};
+    return found;
+}
+
+std::optional<std::pair<int, int>> FindPairInStream(std::istream& input, long long target) {
+    // Non-negative expenses that pair up can't be bigger than the target, so
+    // only those need the bitmap; anything else goes in the table.
+    ValueSet seen(0, std::min<long long>(target, kStreamBitmapLimit), 0);
+    NumberStream numbers(input);
+    int value;
+    while (numbers.Next(value)) {
+        long long complement = target - value;
+        if (seen.Contains(complement)) {
+            return {{static_cast<int>(complement), value}};
+        }
+        seen.Insert(value);
+    }
+    return {};
+}
+
+long long FindPairProduct(const std::vector<int>& numbers, long long target) {
+    return MultiplyEntriesWithSum(numbers, 2, target);
+}
+
+long long FindTripleProduct(const std::vector<int>& numbers, long long target) {
+    return MultiplyEntriesWithSum(numbers, 3, target);
+}
+
+}  // namespace day01
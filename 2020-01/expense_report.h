@@ -0,0 +1,46 @@
+#ifndef AOC_2020_01_EXPENSE_REPORT_H_
+#define AOC_2020_01_EXPENSE_REPORT_H_
+
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace day01 {
+
+constexpr int kExpenseTarget = 2020;
+
+// The largest target whose values FindPairInStream keeps in a bitmap (16MiB).
+constexpr long long kStreamBitmapLimit = 1LL << 27;
+
+// Parses a whitespace-separated list of expenses.
+std::vector<int> ParseNumberList(std::string_view input);
+std::vector<int> ParseNumberListFile(const std::string& file_path);
+
+// Returns 'k' of the numbers, taken from different entries, that sum to
+// 'target', or nothing if no such set exists.
+//
+// Pairs are found in a single pass using a set of the values seen so far; for
+// larger k each entry in turn is fixed and the rest are searched for among the
+// entries after it, reusing the same set.
+std::optional<std::vector<int>> FindEntriesWithSum(const std::vector<int>& numbers, int k, long long target);
+
+// Reads expenses from 'input' until one pairs with an earlier expense to make
+// 'target', and returns that pair without reading any further. Only the set of
+// values seen so far is kept, so inputs larger than memory can be searched:
+// values between 0 and the target go in a bitmap, and anything else in a
+// hash table.
+std::optional<std::pair<int, int>> FindPairInStream(std::istream& input, long long target);
+
+// Returns the product of the two numbers summing to 'target'.
+long long FindPairProduct(const std::vector<int>& numbers, long long target);
+
+// Returns the product of the three numbers summing to 'target'.
+long long FindTripleProduct(const std::vector<int>& numbers, long long target);
+
+}  // namespace day01
+
+#endif  // AOC_2020_01_EXPENSE_REPORT_H_
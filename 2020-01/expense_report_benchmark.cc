@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/microbench.h"
+#include "expense_report.h"
+
+namespace day01 {
+namespace {
+
+// The shipped data repeated range(0) times.
+std::string MakeInput(const BenchmarkState& state) {
+    return RepeatLines(ReadShippedInput("2020-01/data"), state.range(0));
+}
+
+void BM_ParseNumberList(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(ParseNumberList(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_ParseNumberList)->Args({1, 10, 1000});
+
+void BM_FindPairProduct(BenchmarkState& state) {
+    const std::vector<int> numbers = ParseNumberList(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(FindPairProduct(numbers, kExpenseTarget));
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+MICROBENCHMARK(BM_FindPairProduct)->Args({1, 10, 1000});
+
+void BM_FindTripleProduct(BenchmarkState& state) {
+    const std::vector<int> numbers = ParseNumberList(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(FindTripleProduct(numbers, kExpenseTarget));
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+MICROBENCHMARK(BM_FindTripleProduct)->Args({1, 10, 1000});
+
+// range(0) entries over a wide range where only the last two sum to the target,
+// so the whole list has to be searched.
+constexpr int kWideTarget = 2000000000;
+
+std::vector<int> MakeWorstCasePairInput(int64_t size) {
+    std::vector<int> numbers;
+    uint64_t state = 1;
+    for (int64_t i = 0; i < size - 2; ++i) {
+        // Any two of these sum to more than the target.
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        numbers.push_back(kWideTarget / 2 + 1 + (state >> 33) % (kWideTarget / 2 - 2));
+    }
+    numbers.push_back(kWideTarget - 1);
+    numbers.push_back(1);
+    return numbers;
+}
+
+void BM_FindPairProductWorstCase(BenchmarkState& state) {
+    const std::vector<int> numbers = MakeWorstCasePairInput(state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(FindPairProduct(numbers, kWideTarget));
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+MICROBENCHMARK(BM_FindPairProductWorstCase)->Args({1000, 100000, 10000000});
+
+void BM_FindPairInStream(BenchmarkState& state) {
+    std::stringstream text;
+    for (int number : MakeWorstCasePairInput(state.range(0))) {
+        text << number << '\n';
+    }
+    const std::string input = text.str();
+    for ([[maybe_unused]] auto _ : state) {
+        std::istringstream stream(input);
+        DoNotOptimize(FindPairInStream(stream, kWideTarget));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_FindPairInStream)->Args({1000, 100000, 10000000});
+
+}
+
+}  // namespace day01
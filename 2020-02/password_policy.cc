@@ -0,0 +1,166 @@
+#include "password_policy.h"
+
+#include <cctype>
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "../common/input_view.h"
+
+namespace day02 {
+
+namespace {
+
+// Reads the run of digits at line[pos...] into 'value'.
+bool ParseDigits(std::string_view line, size_t& pos, int& value) {
+    if (pos >= line.size() || !std::isdigit(static_cast<unsigned char>(line[pos]))) {
+        return false;
+    }
+    size_t used = ParseIntPrefix(line.substr(pos), value);
+    pos += used;
+    return used > 0;
+}
+
+bool ParseSpace(std::string_view line, size_t& pos) {
+    if (pos >= line.size() || !std::isspace(static_cast<unsigned char>(line[pos]))) {
+        return false;
+    }
+    ++pos;
+    return true;
+}
+
+bool ParseLiteral(std::string_view line, size_t& pos, char c) {
+    if (pos >= line.size() || line[pos] != c) {
+        return false;
+    }
+    ++pos;
+    return true;
+}
+
+bool IsLowercase(char c) {
+    return static_cast<unsigned char>(c - 'a') < 26;
+}
+
+// Checks every character without branching so the loop vectorises.
+bool IsLowercaseWord(std::string_view word) {
+    bool other = false;
+    for (char c : word) {
+        other |= !IsLowercase(c);
+    }
+    return !word.empty() && !other;
+}
+
+std::runtime_error CreateLineMismatchException(std::string_view line) {
+    std::stringstream error_msg;
+    error_msg << "Line didn't match the expected pattern: " << line;
+    return std::runtime_error(error_msg.str());
+}
+
+// Scans one "<first>-<second> <character>: <password>" line in a single pass,
+// with the same rules as the pattern (\d+)-(\d+)\s([a-z]):\s([a-z]+).
+bool ParsePasswordLine(std::string_view line, PasswordRecord& entry) {
+    size_t pos = 0;
+    if (!(ParseDigits(line, pos, entry.first) && ParseLiteral(line, pos, '-')
+          && ParseDigits(line, pos, entry.second) && ParseSpace(line, pos))) {
+        return false;
+    }
+    if (pos >= line.size() || !IsLowercase(line[pos])) {
+        return false;
+    }
+    entry.required_character = line[pos++];
+    if (!(ParseLiteral(line, pos, ':') && ParseSpace(line, pos))) {
+        return false;
+    }
+
+    entry.password = line.substr(pos);
+    return IsLowercaseWord(entry.password);
+}
+
+}
+
+size_t CountCharacter(std::string_view text, char c) {
+    const char* data = text.data();
+    size_t size = text.size();
+    size_t count = 0;
+    size_t i = 0;
+
+#ifdef __AVX2__
+    const __m256i wide_needle = _mm256_set1_epi8(c);
+    for (; i + 32 <= size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        count += __builtin_popcount(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, wide_needle)));
+    }
+#endif
+#ifdef __SSE2__
+    const __m128i needle = _mm_set1_epi8(c);
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+    }
+#endif
+
+    for (; i < size; ++i) {
+        count += data[i] == c;
+    }
+    return count;
+}
+
+PasswordRecord ParsePasswordRecord(std::string_view line) {
+    PasswordRecord record;
+    if (!ParsePasswordLine(line, record)) {
+        throw CreateLineMismatchException(line);
+    }
+    return record;
+}
+
+PasswordDatabase ParsePasswordDatabase(std::string_view input) {
+    LineReader lines(input);
+    std::string_view line;
+    PasswordDatabase database;
+
+    while (lines.Next(line)) {
+        const PasswordRecord record = ParsePasswordRecord(line);
+        database.first.push_back(record.first);
+        database.second.push_back(record.second);
+        database.required_character.push_back(record.required_character);
+        database.passwords.append(record.password);
+        database.password_offsets.push_back(database.passwords.size());
+    }
+
+    return database;
+}
+
+PasswordDatabase ParsePasswordDatabaseFile(const std::string& file_path) {
+    InputView input(file_path);
+    return ParsePasswordDatabase(input.contents());
+}
+
+std::vector<std::string_view> SplitIntoLineChunks(std::string_view input, size_t count) {
+    std::vector<std::string_view> chunks;
+    size_t target_size = std::max<size_t>(1, input.size() / std::max<size_t>(1, count));
+    while (!input.empty()) {
+        size_t end = input.find('\n', std::min(target_size, input.size()) - 1);
+        end = end == std::string_view::npos ? input.size() : end + 1;
+        chunks.push_back(input.substr(0, end));
+        input.remove_prefix(end);
+    }
+    return chunks;
+}
+
+int CountPasswordsValidByOccurrences(const PasswordDatabase& database) {
+    return CountValidPasswords(database, IsValidByOccurrences)[0];
+}
+
+int CountPasswordsValidByPosition(const PasswordDatabase& database) {
+    return CountValidPasswords(database, IsValidByPosition)[0];
+}
+
+}  // namespace day02
@@ -0,0 +1,141 @@
+#ifndef AOC_2020_02_PASSWORD_POLICY_H_
+#define AOC_2020_02_PASSWORD_POLICY_H_
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input_view.h"
+#include "../common/thread_pool.h"
+
+
+namespace day02 {
+
+// One line of the password database, e.g. "1-3 a: abcde".
+struct PasswordRecord {
+    int first;
+    int second;
+    char required_character;
+    std::string_view password;
+};
+
+// The whole database stored by column, with every password packed into one
+// buffer. Password i is passwords[password_offsets[i]..password_offsets[i + 1]).
+struct PasswordDatabase {
+    std::vector<int> first;
+    std::vector<int> second;
+    std::vector<char> required_character;
+    std::vector<size_t> password_offsets = {0};
+    std::string passwords;
+
+    size_t size() const { return first.size(); }
+
+    PasswordRecord operator[](size_t i) const {
+        return {first[i], second[i], required_character[i],
+                std::string_view(passwords).substr(password_offsets[i], password_offsets[i + 1] - password_offsets[i])};
+    }
+};
+
+// Parses one line of the database. The record's password points into 'line'.
+PasswordRecord ParsePasswordRecord(std::string_view line);
+
+PasswordDatabase ParsePasswordDatabase(std::string_view input);
+PasswordDatabase ParsePasswordDatabaseFile(const std::string& file_path);
+
+// Counts the occurrences of 'c' in 'text', a vector register at a time where
+// the target supports it.
+size_t CountCharacter(std::string_view text, char c);
+
+// A policy is anything callable with a PasswordRecord that says whether its
+// password meets the policy. The sweeps below take policies as template
+// arguments, so the checks inline into the loop over the records.
+
+// The password holds the character between 'first' and 'second' times.
+struct OccurrencesPolicy {
+    bool operator()(const PasswordRecord& record) const {
+        const size_t occurrences = CountCharacter(record.password, record.required_character);
+        return static_cast<size_t>(record.first) <= occurrences && occurrences <= static_cast<size_t>(record.second);
+    }
+};
+
+// The password holds the character at exactly one of the 1-based positions
+// 'first' and 'second'.
+struct PositionPolicy {
+    bool operator()(const PasswordRecord& record) const {
+        return HasCharacterAt(record, record.first) != HasCharacterAt(record, record.second);
+    }
+
+  private:
+    // Positions past the end of the password never hold the character.
+    static bool HasCharacterAt(const PasswordRecord& record, int position) {
+        return position >= 1 && static_cast<size_t>(position) <= record.password.size()
+            && record.password[position - 1] == record.required_character;
+    }
+};
+
+inline constexpr OccurrencesPolicy IsValidByOccurrences;
+inline constexpr PositionPolicy IsValidByPosition;
+
+namespace policy_internal {
+
+template <typename... Policies>
+void CountIfValid(const PasswordRecord& record, std::array<int, sizeof...(Policies)>& valid_passwords,
+                  const Policies&... policies) {
+    size_t policy = 0;
+    ((valid_passwords[policy++] += policies(record)), ...);
+}
+
+}  // namespace policy_internal
+
+// Counts the passwords meeting each of the policies in one sweep over the
+// columns, checking every policy against a record before moving on to the
+// next.
+template <typename... Policies>
+std::array<int, sizeof...(Policies)> CountValidPasswords(const PasswordDatabase& database, const Policies&... policies) {
+    std::array<int, sizeof...(Policies)> valid_passwords = {};
+    for (size_t i = 0; i < database.size(); ++i) {
+        policy_internal::CountIfValid(database[i], valid_passwords, policies...);
+    }
+    return valid_passwords;
+}
+
+// Splits 'input' into about 'count' pieces, each ending just after a newline
+// (or at the end of the input).
+std::vector<std::string_view> SplitIntoLineChunks(std::string_view input, size_t count);
+
+// As CountValidPasswords, but straight from the text of the database: it's
+// split into chunks at line boundaries and each chunk's lines are parsed and
+// checked on the pool with their own counts, which are added up at the end.
+template <typename... Policies>
+std::array<int, sizeof...(Policies)> CountValidPasswordsInParallel(
+    std::string_view input, ThreadPool* pool, const Policies&... policies) {
+    // A few chunks per thread so that one slow chunk doesn't hold up the rest.
+    const size_t threads = pool == nullptr ? 1 : pool->size();
+    const std::vector<std::string_view> chunks = SplitIntoLineChunks(input, 4 * threads);
+    std::vector<std::array<int, sizeof...(Policies)>> chunk_counts(chunks.size(), std::array<int, sizeof...(Policies)>{});
+
+    ParallelFor(pool, 0, chunks.size(), [&](int chunk) {
+        LineReader lines(chunks[chunk]);
+        std::string_view line;
+        while (lines.Next(line)) {
+            policy_internal::CountIfValid(ParsePasswordRecord(line), chunk_counts[chunk], policies...);
+        }
+    });
+
+    std::array<int, sizeof...(Policies)> valid_passwords = {};
+    for (const auto& counts : chunk_counts) {
+        for (size_t policy = 0; policy < counts.size(); ++policy) {
+            valid_passwords[policy] += counts[policy];
+        }
+    }
+    return valid_passwords;
+}
+
+int CountPasswordsValidByOccurrences(const PasswordDatabase& database);
+int CountPasswordsValidByPosition(const PasswordDatabase& database);
+
+}  // namespace day02
+
+#endif  // AOC_2020_02_PASSWORD_POLICY_H_
@@ -0,0 +1,76 @@
+#include <string>
+#include <vector>
+
+#include "../common/microbench.h"
+#include "../common/thread_pool.h"
+#include "password_policy.h"
+
+namespace day02 {
+namespace {
+
+// The shipped database repeated range(0) times.
+std::string MakeInput(const BenchmarkState& state) {
+    return RepeatLines(ReadShippedInput("2020-02/data"), state.range(0));
+}
+
+void BM_ParsePasswordDatabase(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(ParsePasswordDatabase(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_ParsePasswordDatabase)->Args({1, 10, 1000});
+
+void BM_CountPasswordsValidByOccurrences(BenchmarkState& state) {
+    const PasswordDatabase database = ParsePasswordDatabase(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountPasswordsValidByOccurrences(database));
+    }
+    state.SetItemsProcessed(state.iterations() * database.size());
+}
+MICROBENCHMARK(BM_CountPasswordsValidByOccurrences)->Args({1, 10, 1000});
+
+void BM_CountPasswordsValidByPosition(BenchmarkState& state) {
+    const PasswordDatabase database = ParsePasswordDatabase(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountPasswordsValidByPosition(database));
+    }
+    state.SetItemsProcessed(state.iterations() * database.size());
+}
+MICROBENCHMARK(BM_CountPasswordsValidByPosition)->Args({1, 10, 1000});
+
+// Both parts' policies in the one sweep.
+void BM_CountValidPasswords(BenchmarkState& state) {
+    const PasswordDatabase database = ParsePasswordDatabase(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountValidPasswords(database, IsValidByOccurrences, IsValidByPosition));
+    }
+    state.SetItemsProcessed(state.iterations() * database.size());
+}
+MICROBENCHMARK(BM_CountValidPasswords)->Args({1, 10, 1000});
+
+// Both policies straight from the text, on a thread per core.
+void BM_CountValidPasswordsInParallel(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    ThreadPool pool;
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountValidPasswordsInParallel(input, &pool, IsValidByOccurrences, IsValidByPosition));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_CountValidPasswordsInParallel)->Args({1, 10, 1000});
+
+// Counting over range(0) bytes of text in one go.
+void BM_CountCharacter(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountCharacter(input, 'x'));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_CountCharacter)->Args({1, 10, 1000});
+
+}
+
+}  // namespace day02
@@ -1,89 +1,53 @@
-#include <exception>
-#include <fstream>
 #include <iostream>
-#include <sstream>
+#include <iterator>
 #include <string>
-#include <utility>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+#include "../common/thread_pool.h"
+#include "toboggan_map.h"
 
-std::vector<bool> ParseLine(std::string line) {
-    std::vector<bool> result;
 
-    for (const char c : line) {
-        switch(c) {
-            case '.':
-                result.push_back(false);
-                break;
-            case '#':
-                result.push_back(true);
-                break;
-            default:
-                std::stringstream stream;
-                stream << "Input file contained illegal character: '" << c << "'";
-                throw std::runtime_error(stream.str());
-        }
-    }
-
-    return result;
-}
-
-std::vector<std::vector<bool>> LoadGridFromFile(std::string filename) {
-    std::vector<std::vector<bool>> result;
-    std::ifstream infile(filename);
-    std::string line;
-
-    while(std::getline(infile, line)) {
-        result.push_back(ParseLine(line));
-    }
-
-    return result;
-}
-
-int CountTreeHits(const std::vector<std::vector<bool>>& map, int velx, int vely) {
-    int trees_hit = 0;
-    int x = 0;
-    int y = 0;
-    int width = map.at(0).size();
-    int height = map.size();
-
-    while (y < height) {
-        if (map.at(y).at(x)) {
-            ++trees_hit;
+int main(int argc, char* argv[]) {
+    // --format=json or --format=csv writes the results in that form rather than
+    // as text. --sweep=<n> ranks every slope up to n across and n down instead
+    // of the puzzle's five, on --threads=<n> threads (one per core by default).
+    day03::OutputFormat format = day03::OutputFormat::TEXT;
+    int max_step = 0;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--format=json") {
+            format = day03::OutputFormat::JSON;
+        } else if (arg == "--format=csv") {
+            format = day03::OutputFormat::CSV;
+        } else if (arg == "--format=text") {
+            format = day03::OutputFormat::TEXT;
+        } else if (arg.rfind("--sweep=", 0) == 0) {
+            max_step = std::stoi(std::string(arg.substr(8)));
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            threads = std::stoi(std::string(arg.substr(10)));
+        } else {
+            positional.push_back(argv[i]);
         }
-
-        x = (x + velx) % width;
-        y += vely;
     }
 
-    return trees_hit;
-}
-
-unsigned long int  MultiplyTreeHitsForAllDirections(
-    const std::vector<std::vector<bool>>& map,
-    const std::vector<std::pair<int, int>>& directions) {
-    unsigned long int result = 1;
-
-    // TODO: Update compiler and use structured bindings.
-    for (const auto x_and_y : directions) {
-        std::cout << x_and_y.first << ", " << x_and_y.second << std::endl;
-        int hits_here = CountTreeHits(map, x_and_y.first, x_and_y.second);
-        result *= hits_here;
-        std::cout << "Hits here: " << hits_here << std::endl;
-    }
-
-    return result;
-}
-
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
+    if (positional.empty()) {
         std::cout << "Must pass a file name to parse!";
         return 1;
     }
 
-    std::vector<std::pair<int, int>> directions = {{1, 1}, {3, 1}, {5, 1}, {7, 1}, {1, 2}};
+    const auto grid = day03::LoadGridFromFile(positional[0]);
+    if (max_step > 0) {
+        ThreadPool pool(threads);
+        const auto ranking = day03::RankSlopesByTreeHits(grid, day03::AllSlopesUpTo(max_step, max_step), &pool);
+        day03::WriteSlopeRanking(ranking, format, std::cout);
+        return 0;
+    }
 
-    const auto grid = LoadGridFromFile(argv[1]);
-    const int trees_hit = MultiplyTreeHitsForAllDirections(grid, directions);
-    std::cout << "Hit " << trees_hit << " trees.";
+    const day03::Slope directions[] = {{1, 1}, {3, 1}, {5, 1}, {7, 1}, {1, 2}};
+    const day03::TreeHitReport report = day03::ReportTreeHits(grid, directions, std::size(directions));
+    day03::WriteTreeHitReport(report, format, std::cout);
 }
\ No newline at end of file
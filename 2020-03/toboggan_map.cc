@@ -0,0 +1,272 @@
+#include "toboggan_map.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input_view.h"
+#include "../common/thread_pool.h"
+
+namespace day03 {
+
+namespace {
+
+constexpr size_t kSlopeBatchSize = 64;
+
+std::runtime_error CreateIllegalCharacterException(char c) {
+    std::stringstream stream;
+    stream << "Input file contained illegal character: '" << c << "'";
+    return std::runtime_error(stream.str());
+}
+
+void ParseLine(std::string_view line, int y, TreeGrid* grid) {
+    if (static_cast<int>(line.size()) != grid->width()) {
+        std::stringstream stream;
+        stream << "Row " << y << " is " << line.size() << " squares wide rather than " << grid->width();
+        throw std::runtime_error(stream.str());
+    }
+
+    for (int x = 0; x < grid->width(); ++x) {
+        switch(line[x]) {
+            case '.':
+                break;
+            case '#':
+                grid->SetTree(x, y);
+                break;
+            default:
+                throw CreateIllegalCharacterException(line[x]);
+        }
+    }
+}
+
+// Follows up to kSlopeBatchSize slopes in one pass down the map, keeping
+// their state on the stack.
+void CountTreeHitsForBatch(const TreeGrid& map, const Slope* slopes, size_t count, int* trees_hit) {
+    const int width = map.width();
+    if (width == 0) {
+        throw std::runtime_error("Can't slide down an empty map!");
+    }
+
+    // Per slope: the step across, already wrapped onto the map, where it is
+    // across the current row, and how many rows until it next lands.
+    int steps[kSlopeBatchSize];
+    int x[kSlopeBatchSize];
+    int rows_to_next[kSlopeBatchSize];
+    for (size_t s = 0; s < count; ++s) {
+        if (slopes[s].down < 1) {
+            std::stringstream stream;
+            stream << "Slopes must go downwards, but got (" << slopes[s].right << ", " << slopes[s].down << ")";
+            throw std::runtime_error(stream.str());
+        }
+        steps[s] = ((slopes[s].right % width) + width) % width;
+        x[s] = 0;
+        rows_to_next[s] = 0;
+        trees_hit[s] = 0;
+    }
+
+    for (int y = 0; y < map.height(); ++y) {
+        const uint64_t* row = map.Row(y);
+        for (size_t s = 0; s < count; ++s) {
+            if (rows_to_next[s] > 0) {
+                --rows_to_next[s];
+                continue;
+            }
+            trees_hit[s] += (row[x[s] / 64] >> (x[s] % 64)) & 1;
+            x[s] += steps[s];
+            if (x[s] >= width) x[s] -= width;
+            rows_to_next[s] = slopes[s].down - 1;
+        }
+    }
+}
+
+void AppendSlopeHits(const SlopeHits& row, OutputFormat format, std::string* out) {
+    const std::string right = std::to_string(row.slope.right);
+    const std::string down = std::to_string(row.slope.down);
+    const std::string trees = std::to_string(row.trees_hit);
+    switch (format) {
+        case OutputFormat::TEXT:
+            *out += right + ", " + down + "\nHits here: " + trees + "\n";
+            break;
+        case OutputFormat::JSON:
+            *out += "{\"right\": " + right + ", \"down\": " + down + ", \"trees\": " + trees + "}";
+            break;
+        case OutputFormat::CSV:
+            *out += right + "," + down + "," + trees + "\n";
+            break;
+    }
+}
+
+// Appends the rows as a JSON array, or as lines of text or CSV.
+void AppendSlopeHitsList(const SlopeHits* rows, size_t count, OutputFormat format, std::string* out) {
+    if (format == OutputFormat::CSV) {
+        *out += "right,down,trees\n";
+    }
+    if (format == OutputFormat::JSON) {
+        *out += "[";
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (format == OutputFormat::JSON && i > 0) {
+            *out += ", ";
+        }
+        AppendSlopeHits(rows[i], format, out);
+    }
+    if (format == OutputFormat::JSON) {
+        *out += "]";
+    }
+}
+
+}
+
+TreeGrid ParseGrid(std::string_view input) {
+    // Count the rows first so the grid can be allocated in one go.
+    LineReader lines(input);
+    std::string_view line;
+    int width = 0;
+    int height = 0;
+    while (lines.Next(line)) {
+        if (height == 0) width = line.size();
+        ++height;
+    }
+
+    TreeGrid result(width, height);
+    lines = LineReader(input);
+    for (int y = 0; lines.Next(line); ++y) {
+        ParseLine(line, y, &result);
+    }
+
+    return result;
+}
+
+TreeGrid LoadGridFromFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseGrid(input.contents());
+}
+
+void CountTreeHitsForSlopes(const TreeGrid& map, const Slope* slopes, size_t count, int* trees_hit) {
+    for (size_t begin = 0; begin < count; begin += kSlopeBatchSize) {
+        size_t batch_size = std::min(kSlopeBatchSize, count - begin);
+        CountTreeHitsForBatch(map, slopes + begin, batch_size, trees_hit + begin);
+    }
+}
+
+std::vector<int> CountTreeHitsForSlopes(const TreeGrid& map, const std::vector<Slope>& slopes) {
+    std::vector<int> trees_hit(slopes.size());
+    CountTreeHitsForSlopes(map, slopes.data(), slopes.size(), trees_hit.data());
+    return trees_hit;
+}
+
+int CountTreeHits(const TreeGrid& map, int velx, int vely) {
+    const Slope slope = {velx, vely};
+    int trees_hit;
+    CountTreeHitsForSlopes(map, &slope, 1, &trees_hit);
+    return trees_hit;
+}
+
+TreeHitReport ReportTreeHits(const TreeGrid& map, const Slope* slopes, size_t count) {
+    if (count > TreeHitReport::kMaxSlopes) {
+        std::stringstream stream;
+        stream << "Can only report on " << TreeHitReport::kMaxSlopes << " slopes at once, not " << count;
+        throw std::runtime_error(stream.str());
+    }
+
+    TreeHitReport report;
+    report.num_slopes = count;
+    int trees_hit[TreeHitReport::kMaxSlopes];
+    CountTreeHitsForSlopes(map, slopes, count, trees_hit);
+
+    for (size_t i = 0; i < count; ++i) {
+        report.rows[i] = {slopes[i], trees_hit[i]};
+        uint64_t factor = trees_hit[i];
+        if (factor != 0 && report.product > UINT64_MAX / factor) {
+            report.product_overflowed = true;
+        }
+        report.product *= factor;
+    }
+    // A single miss makes everything else irrelevant.
+    if (std::find(trees_hit, trees_hit + count, 0) != trees_hit + count) {
+        report.product = 0;
+        report.product_overflowed = false;
+    }
+
+    return report;
+}
+
+std::vector<Slope> AllSlopesUpTo(int max_right, int max_down) {
+    std::vector<Slope> slopes;
+    for (int down = 1; down <= max_down; ++down) {
+        for (int right = 1; right <= max_right; ++right) {
+            slopes.push_back({right, down});
+        }
+    }
+    return slopes;
+}
+
+std::vector<SlopeHits> RankSlopesByTreeHits(const TreeGrid& map, const std::vector<Slope>& slopes, ThreadPool* pool) {
+    // Each batch is one fused pass down the map. Batches are kept small
+    // enough that every thread gets a few, but not so small that the map is
+    // read far more times than needed.
+    size_t threads = pool == nullptr ? 1 : pool->size();
+    size_t batch_size = std::clamp<size_t>(slopes.size() / (4 * threads), 1, kSlopeBatchSize);
+    int batches = (slopes.size() + batch_size - 1) / batch_size;
+
+    std::vector<int> trees_hit(slopes.size());
+    ParallelFor(pool, 0, batches, [&](int batch) {
+        size_t begin = batch * batch_size;
+        size_t end = std::min(slopes.size(), begin + batch_size);
+        CountTreeHitsForBatch(map, slopes.data() + begin, end - begin, trees_hit.data() + begin);
+    });
+
+    std::vector<SlopeHits> result(slopes.size());
+    for (size_t i = 0; i < slopes.size(); ++i) {
+        result[i] = {slopes[i], trees_hit[i]};
+    }
+    std::stable_sort(result.begin(), result.end(), [](const SlopeHits& a, const SlopeHits& b) {
+        return a.trees_hit > b.trees_hit;
+    });
+    return result;
+}
+
+void WriteTreeHitReport(const TreeHitReport& report, OutputFormat format, std::ostream& out) {
+    const std::string product = report.product_overflowed ? "" : std::to_string(report.product);
+    std::string text;
+
+    switch (format) {
+        case OutputFormat::TEXT:
+            AppendSlopeHitsList(report.rows.data(), report.num_slopes, format, &text);
+            text += "Hit " + (report.product_overflowed ? "too many" : product) + " trees.";
+            break;
+        case OutputFormat::JSON:
+            text += "{\"slopes\": ";
+            AppendSlopeHitsList(report.rows.data(), report.num_slopes, format, &text);
+            text += ", \"product\": " + (report.product_overflowed ? "null" : product) + "}\n";
+            break;
+        case OutputFormat::CSV:
+            AppendSlopeHitsList(report.rows.data(), report.num_slopes, format, &text);
+            break;
+    }
+
+    out << text;
+}
+
+void WriteSlopeRanking(const std::vector<SlopeHits>& ranking, OutputFormat format, std::ostream& out) {
+    std::string text;
+    if (format == OutputFormat::TEXT) {
+        text += "right\tdown\ttrees\n";
+        for (const SlopeHits& row : ranking) {
+            text += std::to_string(row.slope.right) + "\t" + std::to_string(row.slope.down) + "\t"
+                + std::to_string(row.trees_hit) + "\n";
+        }
+    } else {
+        AppendSlopeHitsList(ranking.data(), ranking.size(), format, &text);
+        if (format == OutputFormat::JSON) text += "\n";
+    }
+    out << text;
+}
+
+}  // namespace day03
@@ -0,0 +1,115 @@
+#ifndef AOC_2020_03_TOBOGGAN_MAP_H_
+#define AOC_2020_03_TOBOGGAN_MAP_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ThreadPool;
+
+
+namespace day03 {
+
+// The map with one bit per square, set wherever there's a tree. Rows are
+// stored one after another, each padded out to a whole number of 64-bit words.
+class TreeGrid {
+  public:
+    TreeGrid(int width, int height)
+        : width_(width), height_(height), words_per_row_((width + 63) / 64),
+          words_(words_per_row_ * height, 0) {}
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    const uint64_t* Row(int y) const { return words_.data() + y * words_per_row_; }
+
+    bool HasTree(int x, int y) const {
+        return (Row(y)[x / 64] >> (x % 64)) & 1;
+    }
+
+    void SetTree(int x, int y) {
+        words_[y * words_per_row_ + x / 64] |= uint64_t{1} << (x % 64);
+    }
+
+  private:
+    int width_;
+    int height_;
+    size_t words_per_row_;
+    std::vector<uint64_t> words_;
+};
+
+TreeGrid ParseGrid(std::string_view input);
+TreeGrid LoadGridFromFile(const std::string& filename);
+
+// Moving 'right' squares across for every 'down' squares down.
+struct Slope {
+    int right;
+    int down;
+};
+
+// Counts the trees hit sliding from the top left down each of the slopes. The
+// map repeats infinitely to the right. Up to 64 slopes are followed in each
+// pass down the map, so each row is read once per batch rather than once per
+// slope.
+std::vector<int> CountTreeHitsForSlopes(const TreeGrid& map, const std::vector<Slope>& slopes);
+
+// As above, writing the count for slopes[i] to trees_hit[i] without allocating.
+void CountTreeHitsForSlopes(const TreeGrid& map, const Slope* slopes, size_t count, int* trees_hit);
+
+// Counts the trees hit sliding from the top left by (velx, vely) per step.
+int CountTreeHits(const TreeGrid& map, int velx, int vely);
+
+struct SlopeHits {
+    Slope slope;
+    int trees_hit;
+};
+
+// The trees hit down a handful of slopes and the product of those counts, in
+// fixed-size storage so that making one doesn't allocate.
+struct TreeHitReport {
+    static constexpr size_t kMaxSlopes = 64;
+
+    size_t num_slopes = 0;
+    std::array<SlopeHits, kMaxSlopes> rows;
+    uint64_t product = 1;
+    // Set if the product doesn't fit in 64 bits, in which case 'product' is
+    // only the low bits.
+    bool product_overflowed = false;
+};
+
+// Counts the trees hit down up to TreeHitReport::kMaxSlopes slopes.
+TreeHitReport ReportTreeHits(const TreeGrid& map, const Slope* slopes, size_t count);
+
+// Every slope going between 1 and 'max_right' across and between 1 and
+// 'max_down' down.
+std::vector<Slope> AllSlopesUpTo(int max_right, int max_down);
+
+// Counts the trees hit down each of the slopes, with batches of slopes
+// followed in parallel on the pool, all reading the same map. Returns the
+// slopes ordered from most trees hit to fewest, keeping the given order for
+// ties.
+std::vector<SlopeHits> RankSlopesByTreeHits(const TreeGrid& map, const std::vector<Slope>& slopes, ThreadPool* pool);
+
+enum class OutputFormat {
+    // The per-slope lines and total the solver has always printed.
+    TEXT,
+    // An object holding an array of {"right", "down", "trees"} objects and the
+    // product (null if it overflowed).
+    JSON,
+    // A "right,down,trees" header and a line per slope; the product is left
+    // for the reader to work out.
+    CSV,
+};
+
+// Both build the whole output before writing it, so 'out' sees a single write.
+void WriteTreeHitReport(const TreeHitReport& report, OutputFormat format, std::ostream& out);
+// For JSON, the ranking is a bare array of slope objects.
+void WriteSlopeRanking(const std::vector<SlopeHits>& ranking, OutputFormat format, std::ostream& out);
+
+}  // namespace day03
+
+#endif  // AOC_2020_03_TOBOGGAN_MAP_H_
@@ -0,0 +1,97 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../common/microbench.h"
+#include "../common/thread_pool.h"
+#include "toboggan_map.h"
+
+namespace day03 {
+namespace {
+
+// The five slopes from part b.
+const std::vector<Slope> kSlopes = {{1, 1}, {3, 1}, {5, 1}, {7, 1}, {1, 2}};
+
+// The shipped map repeated range(0) times downwards.
+std::string MakeInput(const BenchmarkState& state) {
+    return RepeatLines(ReadShippedInput("2020-03/data"), state.range(0));
+}
+
+// A map 10,000 squares wide and range(0) rows tall, with trees scattered
+// across about a quarter of it.
+TreeGrid MakeWideGrid(const BenchmarkState& state) {
+    TreeGrid grid(10000, state.range(0));
+    uint64_t random = 1;
+    for (int y = 0; y < grid.height(); ++y) {
+        for (int x = 0; x < grid.width(); ++x) {
+            random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+            if ((random >> 62) == 0) grid.SetTree(x, y);
+        }
+    }
+    return grid;
+}
+
+void BM_ParseGrid(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(ParseGrid(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_ParseGrid)->Args({1, 10, 1000});
+
+void BM_CountTreeHits(BenchmarkState& state) {
+    const TreeGrid grid = ParseGrid(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        for (const Slope& slope : kSlopes) {
+            DoNotOptimize(CountTreeHits(grid, slope.right, slope.down));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * grid.height());
+}
+MICROBENCHMARK(BM_CountTreeHits)->Args({1, 10, 1000});
+
+void BM_CountTreeHitsForSlopes(BenchmarkState& state) {
+    const TreeGrid grid = ParseGrid(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountTreeHitsForSlopes(grid, kSlopes));
+    }
+    state.SetItemsProcessed(state.iterations() * grid.height());
+}
+MICROBENCHMARK(BM_CountTreeHitsForSlopes)->Args({1, 10, 1000});
+
+void BM_CountTreeHitsOnWideGrid(BenchmarkState& state) {
+    const TreeGrid grid = MakeWideGrid(state);
+    for ([[maybe_unused]] auto _ : state) {
+        for (const Slope& slope : kSlopes) {
+            DoNotOptimize(CountTreeHits(grid, slope.right, slope.down));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * grid.height());
+}
+MICROBENCHMARK(BM_CountTreeHitsOnWideGrid)->Args({1000, 100000});
+
+void BM_CountTreeHitsForSlopesOnWideGrid(BenchmarkState& state) {
+    const TreeGrid grid = MakeWideGrid(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountTreeHitsForSlopes(grid, kSlopes));
+    }
+    state.SetItemsProcessed(state.iterations() * grid.height());
+}
+MICROBENCHMARK(BM_CountTreeHitsForSlopesOnWideGrid)->Args({1000, 100000});
+
+// Every slope up to 64 by 64, on a thread per core.
+void BM_RankSlopesByTreeHits(BenchmarkState& state) {
+    const TreeGrid grid = ParseGrid(MakeInput(state));
+    const std::vector<Slope> slopes = AllSlopesUpTo(64, 64);
+    ThreadPool pool;
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(RankSlopesByTreeHits(grid, slopes, &pool));
+    }
+    state.SetItemsProcessed(state.iterations() * grid.height() * slopes.size());
+}
+MICROBENCHMARK(BM_RankSlopesByTreeHits)->Args({1, 100});
+
+}
+
+}  // namespace day03
@@ -0,0 +1,14 @@
+#include <iostream>
+
+#include "passport_validator.h"
+
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Must pass a file name to parse!";
+        return 1;
+    }
+
+    const day04::PassportCounts counts = day04::CountPassportsFile(argv[1]);
+    std::cout << "Found " << counts.valid << " valid passports in the input data.";
+}
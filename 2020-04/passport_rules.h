@@ -0,0 +1,259 @@
+#ifndef AOC_2020_04_PASSPORT_RULES_H_
+#define AOC_2020_04_PASSPORT_RULES_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "../common/input_view.h"
+#include "passport_validator.h"
+
+// Rule sets for passports, described as types so that each one is compiled
+// into its own validator with every range and word known up front:
+//
+//   typedef RuleSet<
+//       FieldRule<BIRTH_YEAR, DigitsBetween<4, 1920, 2002>>,
+//       FieldRule<HEIGHT, StartsWithMeasurement<Unit<150, 193, 'c', 'm'>,
+//                                               Unit<59, 76, 'i', 'n'>>>,
+//       FieldRule<COUNTRY_ID, AnyValue>> MyRules;
+//   PassportCounts counts = CountPassportsWithRules<MyRules>(input);
+//
+// Every field named in a rule set is required; fields it doesn't name are
+// ignored. The "StartsWith" checks only look at the start of the value, as the
+// original regexes did, so "170cmx" is a valid height.
+
+
+namespace day04 {
+
+namespace rules_internal {
+
+constexpr bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool IsLowerHexDigit(char c) {
+    return IsDigit(c) || (c >= 'a' && c <= 'f');
+}
+
+constexpr bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+constexpr size_t CountBits(uint8_t mask) {
+    size_t count = 0;
+    for (; mask != 0; mask &= mask - 1) ++count;
+    return count;
+}
+
+// Whether 'text' starts with the characters Chars, compared one at a time so
+// that they end up as immediate operands.
+template <char... Chars>
+bool StartsWith(std::string_view text) {
+    if (text.size() < sizeof...(Chars)) return false;
+    size_t i = 0;
+    return ((text[i++] == Chars) && ...);
+}
+
+}
+
+// Any value at all, for fields that only need to be present.
+struct AnyValue {
+    static bool Matches(std::string_view) { return true; }
+};
+
+// Exactly 'Digits' digits, reading as a number between 'Min' and 'Max'.
+template <int Digits, long long Min, long long Max>
+struct DigitsBetween {
+    static_assert(Digits > 0 && Digits <= 18, "Numbers must have between 1 and 18 digits.");
+    static_assert(Min <= Max, "Empty range of numbers.");
+
+    static bool Matches(std::string_view value) {
+        if (value.size() != Digits) return false;
+        long long number = 0;
+        for (char c : value) {
+            if (!rules_internal::IsDigit(c)) return false;
+            number = 10 * number + (c - '0');
+        }
+        return number >= Min && number <= Max;
+    }
+};
+
+// A unit for StartsWithMeasurement, with the range allowed in it.
+template <int Min, int Max, char... Name>
+struct Unit {
+    static_assert(sizeof...(Name) > 0, "Units need a name.");
+    static_assert(Min >= 0 && Min <= Max, "Empty range of measurements.");
+
+    static constexpr int kMax = Max;
+
+    // Whether 'suffix' starts with this unit's name; if so, 'matches' says
+    // whether the number was in range.
+    static bool StartsWithName(std::string_view suffix, long long number, bool* matches) {
+        if (!rules_internal::StartsWith<Name...>(suffix)) return false;
+        *matches = number >= Min && number <= Max;
+        return true;
+    }
+};
+
+// Starts with a number followed by one of the units, in range for that unit.
+template <typename... Units>
+struct StartsWithMeasurement {
+    static_assert(sizeof...(Units) > 0, "Measurements need at least one unit.");
+
+    static bool Matches(std::string_view value) {
+        // Anything bigger than every unit's maximum is as good as any other,
+        // so long numbers are held there rather than overflowing.
+        constexpr long long kCap = std::max({Units::kMax...}) + 1LL;
+        size_t digits = 0;
+        long long number = 0;
+        while (digits < value.size() && rules_internal::IsDigit(value[digits])) {
+            number = std::min(10 * number + (value[digits] - '0'), kCap);
+            ++digits;
+        }
+        if (digits == 0) return false;
+
+        const std::string_view suffix = value.substr(digits);
+        bool matches = false;
+        (Units::StartsWithName(suffix, number, &matches) || ...);
+        return matches;
+    }
+};
+
+// Starts with '#' and 'Digits' lower-case hex digits.
+template <int Digits>
+struct StartsWithHexColour {
+    static_assert(Digits > 0, "Colours need at least one digit.");
+
+    static bool Matches(std::string_view value) {
+        if (value.size() < Digits + 1 || value[0] != '#') return false;
+        for (int i = 1; i <= Digits; ++i) {
+            if (!rules_internal::IsLowerHexDigit(value[i])) return false;
+        }
+        return true;
+    }
+};
+
+// A word for StartsWithOneOf.
+template <char... Chars>
+struct Word {
+    static_assert(sizeof...(Chars) > 0, "Words can't be empty.");
+
+    static bool IsPrefixOf(std::string_view value) {
+        return rules_internal::StartsWith<Chars...>(value);
+    }
+};
+
+// Starts with one of the words.
+template <typename... Words>
+struct StartsWithOneOf {
+    static_assert(sizeof...(Words) > 0, "Need at least one word to match.");
+
+    static bool Matches(std::string_view value) {
+        return (Words::IsPrefixOf(value) || ...);
+    }
+};
+
+// Checks 'Field' with 'Check', which is one of the types above or anything
+// else with a static Matches(std::string_view).
+template <PassportField Field, typename Check>
+struct FieldRule {
+    static constexpr PassportField kField = Field;
+
+    static bool Matches(std::string_view value) {
+        return Check::Matches(value);
+    }
+};
+
+template <typename... FieldRules>
+struct RuleSet {
+    static_assert(sizeof...(FieldRules) > 0, "Rule sets need at least one field.");
+
+    // The fields the rules name, all of which are required.
+    static constexpr uint8_t kRequiredMask = (0 | ... | (1 << FieldRules::kField));
+
+    static_assert(rules_internal::CountBits(kRequiredMask) == sizeof...(FieldRules),
+                  "Rule sets can't check a field twice.");
+
+    // Whether 'value' passes the rule for 'field'; fields without a rule
+    // accept anything.
+    static bool Matches(PassportField field, std::string_view value) {
+        bool matches = true;
+        ((field == FieldRules::kField && (matches = FieldRules::Matches(value), true)) || ...);
+        return matches;
+    }
+};
+
+// The rules from the puzzle.
+typedef RuleSet<
+    FieldRule<BIRTH_YEAR, DigitsBetween<4, 1920, 2002>>,
+    FieldRule<ISSUE_YEAR, DigitsBetween<4, 2010, 2020>>,
+    FieldRule<EXPIRATION_YEAR, DigitsBetween<4, 2020, 2030>>,
+    FieldRule<HEIGHT, StartsWithMeasurement<Unit<150, 193, 'c', 'm'>, Unit<59, 76, 'i', 'n'>>>,
+    FieldRule<HAIR_COLOUR, StartsWithHexColour<6>>,
+    FieldRule<EYE_COLOUR, StartsWithOneOf<Word<'a', 'm', 'b'>, Word<'b', 'l', 'u'>, Word<'b', 'r', 'n'>,
+                                          Word<'g', 'r', 'y'>, Word<'g', 'r', 'n'>, Word<'h', 'z', 'l'>,
+                                          Word<'o', 't', 'h'>>>,
+    FieldRule<PASSPORT_ID, DigitsBetween<9, 0, 999999999>>> PuzzleRules;
+
+
+// Counts, in one pass over the text, the passports with every field 'Rules'
+// names (complete) and those whose fields all pass their rules too (valid).
+template <typename Rules>
+PassportCounts CountPassportsWithRules(std::string_view input) {
+    PassportCounts counts;
+    // Bitmasks by field of what the current passport has.
+    uint8_t present = 0;
+    uint8_t valid = 0;
+
+    auto finish_passport = [&]() {
+        counts.complete += (present & Rules::kRequiredMask) == Rules::kRequiredMask;
+        counts.valid += (valid & Rules::kRequiredMask) == Rules::kRequiredMask;
+        present = 0;
+        valid = 0;
+    };
+
+    auto add_field = [&](std::string_view token) {
+        // A field needs a key and a value either side of its first colon.
+        const size_t colon = token.find(':');
+        if (colon == 0 || colon == std::string_view::npos || colon + 1 == token.size()) return;
+
+        const std::optional<PassportField> field = LookUpField(token.substr(0, colon));
+        if (!field) return;
+
+        // A repeated field replaces the earlier one, validity included.
+        const uint8_t bit = 1 << *field;
+        present |= bit;
+        if (Rules::Matches(*field, token.substr(colon + 1))) {
+            valid |= bit;
+        } else {
+            valid &= ~bit;
+        }
+    };
+
+    LineReader lines(input);
+    std::string_view line;
+    while (lines.Next(line)) {
+        if (line.empty()) {
+            finish_passport();
+            continue;
+        }
+
+        size_t pos = 0;
+        while (pos < line.size()) {
+            while (pos < line.size() && rules_internal::IsSpace(line[pos])) ++pos;
+            size_t end = pos;
+            while (end < line.size() && !rules_internal::IsSpace(line[end])) ++end;
+            if (end > pos) add_field(line.substr(pos, end - pos));
+            pos = end;
+        }
+    }
+    finish_passport();
+
+    return counts;
+}
+
+}  // namespace day04
+
+#endif  // AOC_2020_04_PASSPORT_RULES_H_
@@ -0,0 +1,70 @@
+#include "passport_validator.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "../common/input_view.h"
+#include "passport_rules.h"
+
+namespace day04 {
+
+namespace {
+
+constexpr std::array<std::string_view, 8> kFieldKeys = {"byr", "iyr", "eyr", "hgt", "hcl", "ecl", "pid", "cid"};
+
+// A perfect hash of the three-letter keys into sixteen slots, found by trying
+// small multipliers until no two keys collided.
+constexpr size_t kKeyTableSize = 16;
+
+constexpr size_t HashKey(std::string_view key) {
+    return (5 * (key[0] + key[1]) + key[2]) & (kKeyTableSize - 1);
+}
+
+// Slot -> field, or -1 where no key hashes.
+constexpr std::array<int, kKeyTableSize> BuildKeyTable() {
+    std::array<int, kKeyTableSize> table = {};
+    for (int& entry : table) entry = -1;
+    for (size_t field = 0; field < kFieldKeys.size(); ++field) {
+        table[HashKey(kFieldKeys[field])] = field;
+    }
+    return table;
+}
+
+constexpr std::array<int, kKeyTableSize> kKeyTable = BuildKeyTable();
+
+constexpr bool KeyTableIsPerfect() {
+    for (size_t field = 0; field < kFieldKeys.size(); ++field) {
+        if (kKeyTable[HashKey(kFieldKeys[field])] != static_cast<int>(field)) return false;
+    }
+    return true;
+}
+
+static_assert(KeyTableIsPerfect(), "Two passport keys share a slot; pick another hash.");
+
+}
+
+std::optional<PassportField> LookUpField(std::string_view key) {
+    if (key.size() != 3) return {};
+    int field = kKeyTable[HashKey(key)];
+    if (field < 0 || kFieldKeys[field] != key) return {};
+    return static_cast<PassportField>(field);
+}
+
+bool IsValidFieldValue(PassportField field, std::string_view value) {
+    return PuzzleRules::Matches(field, value);
+}
+
+PassportCounts CountPassports(std::string_view input) {
+    return CountPassportsWithRules<PuzzleRules>(input);
+}
+
+PassportCounts CountPassportsFile(const std::string& filename) {
+    InputView input(filename);
+    return CountPassports(input.contents());
+}
+
+}  // namespace day04
@@ -0,0 +1,45 @@
+#ifndef AOC_2020_04_PASSPORT_VALIDATOR_H_
+#define AOC_2020_04_PASSPORT_VALIDATOR_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+
+namespace day04 {
+
+enum PassportField {
+    BIRTH_YEAR,       // byr
+    ISSUE_YEAR,       // iyr
+    EXPIRATION_YEAR,  // eyr
+    HEIGHT,           // hgt
+    HAIR_COLOUR,      // hcl
+    EYE_COLOUR,       // ecl
+    PASSPORT_ID,      // pid
+    COUNTRY_ID,       // cid, which isn't required.
+};
+
+// Finds the field with the given key, or nothing if it isn't one we know.
+std::optional<PassportField> LookUpField(std::string_view key);
+
+// Checks a field's value against the rules from part b (PuzzleRules in
+// passport_rules.h).
+bool IsValidFieldValue(PassportField field, std::string_view value);
+
+struct PassportCounts {
+    // Passports with every required field (part a).
+    int complete = 0;
+    // Passports with every required field, all holding valid values (part b).
+    int valid = 0;
+};
+
+// Counts the complete and valid passports in a single pass over the text, by
+// the rules from the puzzle; CountPassportsWithRules takes others. Passports
+// are separated by blank lines and hold whitespace-separated "key:value"
+// fields; if a key appears twice, the last value counts.
+PassportCounts CountPassports(std::string_view input);
+PassportCounts CountPassportsFile(const std::string& filename);
+
+}  // namespace day04
+
+#endif  // AOC_2020_04_PASSPORT_VALIDATOR_H_
@@ -0,0 +1,45 @@
+#include <string>
+
+#include "../common/microbench.h"
+#include "passport_rules.h"
+#include "passport_validator.h"
+
+namespace day04 {
+namespace {
+
+// The shipped passports repeated range(0) times.
+std::string MakeInput(const BenchmarkState& state) {
+    return RepeatLines(ReadShippedInput("2020-04/data"), state.range(0));
+}
+
+// Both parts' counts in the one pass over the text.
+void BM_CountPassports(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountPassports(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_CountPassports)->Args({1, 10, 1000});
+
+// A different rule set, which also wants a country and only takes heights in
+// centimetres.
+typedef RuleSet<
+    FieldRule<BIRTH_YEAR, DigitsBetween<4, 1950, 2005>>,
+    FieldRule<HEIGHT, StartsWithMeasurement<Unit<140, 210, 'c', 'm'>>>,
+    FieldRule<EYE_COLOUR, StartsWithOneOf<Word<'b', 'l', 'u'>, Word<'b', 'r', 'n'>>>,
+    FieldRule<PASSPORT_ID, DigitsBetween<9, 0, 999999999>>,
+    FieldRule<COUNTRY_ID, AnyValue>> OtherRules;
+
+void BM_CountPassportsWithOtherRules(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountPassportsWithRules<OtherRules>(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_CountPassportsWithOtherRules)->Args({1, 10, 1000});
+
+}
+
+}  // namespace day04
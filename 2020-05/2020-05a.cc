@@ -1,105 +1,78 @@
+#include <cstdint>
 #include <exception>
-#include <fstream>
 #include <iostream>
 #include <sstream>
-#include <regex>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "boarding_pass.h"
 
-const std::string kBookingRegex = R"(^(F|B){7}(L|R){3}$)";
 
+std::runtime_error CreateMalformattedBookingException(const std::string& booking) {
+    std::stringstream error_msg;
+    error_msg << "Malformatted booking: " << booking << ". This should have been caught earlier!";
+    return std::runtime_error(error_msg.str());
+}
 
-std::vector<std::string> ParseBookings(const std::string& file_path) {
-    std::vector<std::string> bookings;
-    const std::regex booking_regex(kBookingRegex);
-    std::smatch match;
+std::pair<int64_t, int64_t> ParseRowAndSeat(const std::string& booking, const day05::PlaneShape& shape) {
+    int64_t seat_number = 0;
+    int64_t row_number = 0;
+    int64_t seat_add = 1;
+    int64_t row_add = 1;
 
-    std::ifstream infile(file_path);
-    std::string line;
-    while (std::getline(infile, line)) {
-        if (!std::regex_match(line, match, booking_regex)) {
-            std::stringstream error_msg;
-            error_msg << "Malformatted booking line: " << line;
-            throw std::runtime_error(error_msg.str());
-        }
-        bookings.push_back(line);
+    if (static_cast<int>(booking.length()) != shape.bits()) {
+        throw CreateMalformattedBookingException(booking);
     }
 
-    return bookings;
-}
-
-std::pair<int, int> ParseRowAndSeat(const std::string& booking) {
-    int seat_number = 0;
-    int row_number = 0;
-    int seat_add = 1;
-    int row_add = 1;
-
     int parseIndex = booking.length() - 1;
 
-    for (; booking[parseIndex] == 'L' || booking[parseIndex] == 'R'; --parseIndex) {
-        if (booking[parseIndex] == 'R'){
+    for (int i = 0; i < shape.column_bits; ++i, --parseIndex) {
+        if (booking[parseIndex] == shape.column_letters.upper) {
             seat_number += seat_add;
+        } else if (booking[parseIndex] != shape.column_letters.lower) {
+            throw CreateMalformattedBookingException(booking);
         }
         seat_add *= 2;
     }
 
-    for (; parseIndex >= 0 && (booking[parseIndex] == 'F' || booking[parseIndex] == 'B'); --parseIndex) {
-        if (booking[parseIndex] == 'B') {
+    for (; parseIndex >= 0; --parseIndex) {
+        if (booking[parseIndex] == shape.row_letters.upper) {
             row_number += row_add;
+        } else if (booking[parseIndex] != shape.row_letters.lower) {
+            throw CreateMalformattedBookingException(booking);
         }
         row_add *= 2;
     }
 
-    if (parseIndex >= 0) {
-        std::stringstream error_msg;
-        error_msg << "Malformatted booking: " << booking << ". This should have been caught earlier!";
-        throw std::runtime_error(error_msg.str());
-    }
-
     return {row_number, seat_number};
 }
 
-int GetSeatIdMoreDescriptively(const std::string& booking) {
-    auto [row, column] = ParseRowAndSeat(booking);
-    return row * 8 + column;
-}
-
-int GetSeatIdQuickly(const std::string& booking) {
-    int result = 0;
-    int add = 1;
-
-    for (int i = booking.length() - 1; i >= 0; --i) {
-        if (booking[i] == 'B' || booking[i] == 'R') {
-            result += add;
-        }
-        add *= 2;
-    }
-
-    return result;
+int64_t GetSeatIdMoreDescriptively(const std::string& booking, const day05::PlaneShape& shape) {
+    auto [row, column] = ParseRowAndSeat(booking, shape);
+    return shape.SeatId(row, column);
 }
 
-int GetHighestSeatId(const std::vector<std::string>& bookings) {
-    int max = -1;
 
-    for (const auto& booking : bookings) {
-        int seat_id = GetSeatIdQuickly(booking);
-        if (seat_id > max) {
-            max = seat_id;
+int main(int argc, char* argv[]) {
+    // --row-bits=<n>, --column-bits=<n>, --row-letters=<lower><upper> and
+    // --column-letters=<lower><upper> read passes for a plane of another shape
+    // than the puzzle's 7 F/B and 3 L/R.
+    day05::PlaneShape shape;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (!day05::ParsePlaneShapeFlag(arg, &shape)) {
+            positional.push_back(argv[i]);
         }
     }
 
-    return max;
-}
-
-
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
+    if (positional.empty()) {
         std::cout << "Must pass a file name to parse!";
         return 1;
     }
 
-    std::vector<std::string> bookings = ParseBookings(std::string(argv[1]));
-    int highest_seat_id = GetHighestSeatId(bookings);
-    std::cout << "Highest seat ID: " << highest_seat_id << std::endl;
+    const day05::SeatIdSummary summary = day05::SummariseSeatIdsFile(positional[0], shape);
+    std::cout << "Highest seat ID: " << summary.highest() << std::endl;
 }
\ No newline at end of file
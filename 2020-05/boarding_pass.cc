@@ -0,0 +1,340 @@
+#include "boarding_pass.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+#include "../common/input_view.h"
+
+namespace day05 {
+
+namespace {
+
+// How many characters of a pass each vector load covers.
+constexpr int kLoadWidth = 16;
+
+// Enough loads to cover the longest pass.
+constexpr int kMaxChunks = (kMaxPassBits + kLoadWidth - 1) / kLoadWidth;
+
+std::runtime_error CreateMalformedBookingException(std::string_view text, size_t line_start) {
+    std::string_view line = text.substr(line_start);
+    line = line.substr(0, line.find('\n'));
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    std::stringstream error_msg;
+    error_msg << "Malformatted booking line: " << line;
+    return std::runtime_error(error_msg.str());
+}
+
+void CheckShape(const PlaneShape& shape, int max_bits) {
+    if (shape.row_bits < 0 || shape.column_bits < 0 || shape.bits() < 1 || shape.bits() > max_bits) {
+        std::stringstream error_msg;
+        error_msg << "Can't decode passes with " << shape.row_bits << " row and " << shape.column_bits
+                  << " column characters; there must be between 1 and " << max_bits << " in all.";
+        throw std::runtime_error(error_msg.str());
+    }
+    if (shape.row_letters.lower == shape.row_letters.upper ||
+        shape.column_letters.lower == shape.column_letters.upper) {
+        throw std::runtime_error("The two halves of a row or column need different letters!");
+    }
+}
+
+// XOR of every integer in [0, n].
+int64_t XorUpTo(int64_t n) {
+    switch (n % 4) {
+        case 0: return n;
+        case 1: return 1;
+        case 2: return n + 1;
+        default: return 0;
+    }
+}
+
+// Everything needed to decode passes of one shape. Pass characters
+// [16c, 16c + chunk_bits[c]) make up chunk c, which is read in one load and
+// reversed by reverse[c] so that its first character lands in the top bit of
+// the movemask; upper[c] and lower[c] hold the letters for the reversed
+// positions. Lanes past the end of a chunk are zeroed by the shuffle, and
+// their letters (-1) can't match that.
+struct DecodeTables {
+    int length = 0;
+    int chunks = 0;
+    int chunk_bits[kMaxChunks] = {};
+    alignas(16) char reverse[kMaxChunks][kLoadWidth] = {};
+    alignas(16) char upper[kMaxChunks][kLoadWidth] = {};
+    alignas(16) char lower[kMaxChunks][kLoadWidth] = {};
+};
+
+constexpr DecodeTables BuildDecodeTables(const PlaneShape& shape) {
+    DecodeTables tables;
+    tables.length = shape.bits();
+    tables.chunks = (tables.length + kLoadWidth - 1) / kLoadWidth;
+    for (int c = 0; c < tables.chunks; ++c) {
+        const int start = c * kLoadWidth;
+        const int bits = std::min(kLoadWidth, tables.length - start);
+        tables.chunk_bits[c] = bits;
+        for (int j = 0; j < kLoadWidth; ++j) {
+            const int i = start + bits - 1 - j;
+            const SeatLetters letters = i < shape.row_bits ? shape.row_letters : shape.column_letters;
+            tables.reverse[c][j] = j < bits ? bits - 1 - j : -1;
+            tables.upper[c][j] = j < bits ? letters.upper : -1;
+            tables.lower[c][j] = j < bits ? letters.lower : -1;
+        }
+    }
+    return tables;
+}
+
+// A plane shape whose tables are built at compile time.
+template <int RowBits, int ColumnBits, char RowLower = 'F', char RowUpper = 'B', char ColumnLower = 'L',
+          char ColumnUpper = 'R'>
+struct FixedPlaneShape {
+    static constexpr PlaneShape kShape = {RowBits, ColumnBits, {RowLower, RowUpper}, {ColumnLower, ColumnUpper}};
+    static constexpr DecodeTables kTables = BuildDecodeTables(kShape);
+};
+
+// Shapes common enough to decode with fixed tables: the puzzle's plane, and
+// planes with half and twice as many rows.
+typedef std::tuple<FixedPlaneShape<7, 3>, FixedPlaneShape<6, 3>, FixedPlaneShape<8, 3>> CommonPlaneShapes;
+
+// Decodes the pass at 'pass', which must have kChunks * kLoadWidth bytes
+// readable. Returns -1 if it's malformed and 'validate' is set. Every chunk
+// is decoded the same way whatever the letters, so the only branch is on
+// whether to validate, which is the same for every pass.
+template <int kChunks>
+inline int64_t DecodePass(const DecodeTables& tables, const char* pass, bool validate) {
+    int64_t seat_id = 0;
+    bool valid = true;
+    for (int c = 0; c < kChunks; ++c) {
+#if defined(__SSSE3__)
+        const __m128i reverse = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.reverse[c]));
+        const __m128i upper = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.upper[c]));
+        const __m128i bytes = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pass + c * kLoadWidth)), reverse);
+        const __m128i ones = _mm_cmpeq_epi8(bytes, upper);
+        seat_id = (seat_id << tables.chunk_bits[c]) | _mm_movemask_epi8(ones);
+        if (validate) {
+            const __m128i lower = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.lower[c]));
+            const __m128i known = _mm_or_si128(ones, _mm_cmpeq_epi8(bytes, lower));
+            valid &= _mm_movemask_epi8(known) == (1 << tables.chunk_bits[c]) - 1;
+        }
+#else
+        const int bits = tables.chunk_bits[c];
+        for (int j = bits - 1; j >= 0; --j) {
+            const char letter = pass[c * kLoadWidth + bits - 1 - j];
+            const bool one = letter == tables.upper[c][j];
+            seat_id = 2 * seat_id + one;
+            if (validate) valid &= one || letter == tables.lower[c][j];
+        }
+#endif
+    }
+    return valid ? seat_id : -1;
+}
+
+// Decodes passes from text[pos..] for as long as every load from the next one
+// stays within the first 'readable' bytes, handing their IDs to 'sink'.
+// Returns where it stopped.
+template <int kChunks, typename Sink>
+size_t DecodePasses(std::string_view text, size_t pos, size_t readable, const DecodeTables& tables,
+                    bool validate, Sink& sink) {
+    const char* data = text.data();
+    const size_t length = tables.length;
+    while (pos < text.size() && pos + kChunks * kLoadWidth <= readable) {
+        if (text.size() - pos < length) {
+            throw CreateMalformedBookingException(text, pos);
+        }
+
+        const int64_t seat_id = DecodePass<kChunks>(tables, data + pos, validate);
+        if (seat_id < 0) {
+            throw CreateMalformedBookingException(text, pos);
+        }
+        sink(seat_id);
+
+        // Step over the line ending, which must come straight after the pass.
+        pos += length;
+        if (pos < text.size() && data[pos] == '\r') ++pos;
+        if (pos < text.size()) {
+            if (data[pos] == '\n') {
+                ++pos;
+            } else if (validate) {
+                throw CreateMalformedBookingException(text, pos - length);
+            }
+        }
+    }
+    return pos;
+}
+
+template <int kChunks, typename Sink>
+void DecodeAllPassesWith(std::string_view input, const DecodeTables& tables, Validation validation, Sink& sink) {
+    const bool validate = validation == Validation::STRICT;
+    const size_t pos = DecodePasses<kChunks>(input, 0, input.size(), tables, validate, sink);
+
+    // The last few passes are too close to the end to load directly, so they
+    // go through a copy with room to spare.
+    if (pos < input.size()) {
+        char tail[2 * kMaxChunks * kLoadWidth] = {};
+        const std::string_view rest = input.substr(pos);
+        std::memcpy(tail, rest.data(), rest.size());
+        DecodePasses<kChunks>(std::string_view(tail, rest.size()), 0, sizeof(tail), tables, validate, sink);
+    }
+}
+
+// Decodes with the fixed tables of the first common shape matching 'shape',
+// returning false if none does.
+template <typename Sink, typename... Shapes>
+bool DecodeAllPassesWithFixedShape(std::string_view input, const PlaneShape& shape, Validation validation, Sink& sink,
+                                   std::tuple<Shapes...>*) {
+    return ((shape == Shapes::kShape &&
+             (DecodeAllPassesWith<Shapes::kTables.chunks>(input, Shapes::kTables, validation, sink), true)) || ...);
+}
+
+// Decodes every pass in 'input', handing their IDs to 'sink' in order.
+template <typename Sink>
+void DecodeAllPasses(std::string_view input, const PlaneShape& shape, Validation validation, Sink& sink) {
+    if (DecodeAllPassesWithFixedShape(input, shape, validation, sink, static_cast<CommonPlaneShapes*>(nullptr))) {
+        return;
+    }
+
+    const DecodeTables tables = BuildDecodeTables(shape);
+    switch (tables.chunks) {
+        case 1:
+            DecodeAllPassesWith<1>(input, tables, validation, sink);
+            break;
+        case 2:
+            DecodeAllPassesWith<2>(input, tables, validation, sink);
+            break;
+        case 3:
+            DecodeAllPassesWith<3>(input, tables, validation, sink);
+            break;
+        default:
+            static_assert(kMaxChunks == 4, "Add a case for every number of chunks.");
+            DecodeAllPassesWith<4>(input, tables, validation, sink);
+            break;
+    }
+}
+
+}
+
+bool ParsePlaneShapeFlag(std::string_view arg, PlaneShape* shape) {
+    auto parse_letters = [arg](std::string_view value) {
+        if (value.size() != 2) {
+            std::stringstream error_msg;
+            error_msg << "Expected two letters, lower half first, in '" << arg << "'!";
+            throw std::runtime_error(error_msg.str());
+        }
+        return SeatLetters{value[0], value[1]};
+    };
+
+    if (arg.rfind("--row-bits=", 0) == 0) {
+        shape->row_bits = ParseInt(arg.substr(11));
+    } else if (arg.rfind("--column-bits=", 0) == 0) {
+        shape->column_bits = ParseInt(arg.substr(14));
+    } else if (arg.rfind("--row-letters=", 0) == 0) {
+        shape->row_letters = parse_letters(arg.substr(14));
+    } else if (arg.rfind("--column-letters=", 0) == 0) {
+        shape->column_letters = parse_letters(arg.substr(17));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::vector<int> DecodeSeatIds(std::string_view input, PlaneShape shape, Validation validation) {
+    CheckShape(shape, 31);
+    std::vector<int> seat_ids;
+    seat_ids.reserve(input.size() / (shape.bits() + 1) + 1);
+    auto append = [&seat_ids](int64_t seat_id) { seat_ids.push_back(seat_id); };
+    DecodeAllPasses(input, shape, validation, append);
+    return seat_ids;
+}
+
+std::vector<int> DecodeSeatIdsFile(const std::string& file_path, PlaneShape shape, Validation validation) {
+    InputView input(file_path);
+    return DecodeSeatIds(input.contents(), shape, validation);
+}
+
+std::optional<int64_t> SeatIdSummary::MissingSeatId() const {
+    if (count_ == 0 || highest_ - lowest_ != count_) return {};
+    const int64_t xor_of_range = XorUpTo(highest_) ^ (lowest_ == 0 ? 0 : XorUpTo(lowest_ - 1));
+    return xor_of_range ^ xor_of_ids_;
+}
+
+SeatIdSummary SummariseSeatIds(std::string_view input, PlaneShape shape, Validation validation) {
+    CheckShape(shape, kMaxPassBits);
+    SeatIdSummary summary;
+    auto add = [&summary](int64_t seat_id) { summary.Add(seat_id); };
+    DecodeAllPasses(input, shape, validation, add);
+    return summary;
+}
+
+SeatIdSummary SummariseSeatIdsFile(const std::string& file_path, PlaneShape shape, Validation validation) {
+    InputView input(file_path);
+    return SummariseSeatIds(input.contents(), shape, validation);
+}
+
+int64_t DecodeSeatId(std::string_view booking, PlaneShape shape) {
+    CheckShape(shape, kMaxPassBits);
+    std::optional<int64_t> seat_id;
+    auto keep = [&seat_id](int64_t id) { seat_id = id; };
+    if (booking.find('\n') != std::string_view::npos) {
+        throw CreateMalformedBookingException(booking, 0);
+    }
+    DecodeAllPasses(booking, shape, Validation::STRICT, keep);
+    if (!seat_id) {
+        throw CreateMalformedBookingException(booking, 0);
+    }
+    return *seat_id;
+}
+
+int64_t GetSeatIdQuickly(std::string_view booking) {
+    int64_t result = 0;
+    int64_t add = 1;
+
+    for (int i = booking.length() - 1; i >= 0; --i) {
+        if (booking[i] == 'B' || booking[i] == 'R') {
+            result += add;
+        }
+        add *= 2;
+    }
+
+    return result;
+}
+
+int GetHighestSeatId(const std::vector<int>& seat_ids) {
+    int max = -1;
+
+    for (int seat_id : seat_ids) {
+        if (seat_id > max) {
+            max = seat_id;
+        }
+    }
+
+    return max;
+}
+
+int GetMissingSeatId(const std::vector<int>& seat_ids) {
+    SeatIdSummary summary;
+    for (int seat_id : seat_ids) {
+        summary.Add(seat_id);
+    }
+
+    const std::optional<int64_t> missing = summary.MissingSeatId();
+    if (!missing) {
+        throw std::runtime_error("Seat IDs don't form a contiguous run with exactly one gap!");
+    }
+    return *missing;
+}
+
+}  // namespace day05
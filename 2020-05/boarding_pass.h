@@ -0,0 +1,117 @@
+#ifndef AOC_2020_05_BOARDING_PASS_H_
+#define AOC_2020_05_BOARDING_PASS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace day05 {
+
+enum class Validation {
+    // Reject any line that isn't the plane's row letters followed by its
+    // column letters.
+    STRICT,
+    // Assume every line is well-formed and only decode it.
+    TRUSTED,
+};
+
+// The letters a pass uses to pick the lower or upper half at each step.
+struct SeatLetters {
+    char lower;
+    char upper;
+
+    constexpr bool operator==(const SeatLetters& other) const { return lower == other.lower && upper == other.upper; }
+};
+
+// How many row and column characters a plane's boarding passes have, and
+// which letters they use. The puzzle's plane has 128 rows of 8 seats, picked
+// with F/B and then L/R.
+struct PlaneShape {
+    int row_bits = 7;
+    int column_bits = 3;
+    SeatLetters row_letters = {'F', 'B'};
+    SeatLetters column_letters = {'L', 'R'};
+
+    constexpr int bits() const { return row_bits + column_bits; }
+
+    constexpr int64_t SeatId(int64_t row, int64_t column) const { return (row << column_bits) | column; }
+    constexpr int64_t Row(int64_t seat_id) const { return seat_id >> column_bits; }
+    constexpr int64_t Column(int64_t seat_id) const { return seat_id & ((int64_t{1} << column_bits) - 1); }
+
+    constexpr bool operator==(const PlaneShape& other) const {
+        return row_bits == other.row_bits && column_bits == other.column_bits &&
+               row_letters == other.row_letters && column_letters == other.column_letters;
+    }
+};
+
+// Applies a command-line flag describing the plane to 'shape': --row-bits=<n>,
+// --column-bits=<n>, --row-letters=<lower><upper> or
+// --column-letters=<lower><upper>. Returns false if 'arg' isn't one of them.
+bool ParsePlaneShapeFlag(std::string_view arg, PlaneShape* shape);
+
+// The largest number of characters a boarding pass can have.
+constexpr int kMaxPassBits = 62;
+
+// Decodes one booking per line, each like "FBFBBFFRLR", straight to its seat
+// ID, in input order. Where the target supports it each pass is read sixteen
+// characters to a vector load and decoded with a compare and movemask. A few
+// common shapes, the puzzle's among them, have their decoders built at compile
+// time; any other shape gets one built when decoding starts. Seat IDs must fit
+// in an int, so planes can have at most 31 bits here.
+std::vector<int> DecodeSeatIds(
+    std::string_view input, PlaneShape shape = {}, Validation validation = Validation::STRICT);
+std::vector<int> DecodeSeatIdsFile(
+    const std::string& file_path, PlaneShape shape = {}, Validation validation = Validation::STRICT);
+
+// What one pass over a list of seat IDs learns about them, in constant space.
+class SeatIdSummary {
+  public:
+    void Add(int64_t seat_id) {
+        lowest_ = std::min(lowest_, seat_id);
+        highest_ = std::max(highest_, seat_id);
+        ++count_;
+        xor_of_ids_ ^= seat_id;
+    }
+
+    int64_t count() const { return count_; }
+    // Both -1 if there were no IDs.
+    int64_t lowest() const { return count_ == 0 ? -1 : lowest_; }
+    int64_t highest() const { return count_ == 0 ? -1 : highest_; }
+
+    // The one seat between the lowest and highest that wasn't seen, found by
+    // XORing every ID in that range with those that were. Nothing if the IDs
+    // don't fill the range bar one; duplicates aren't expected.
+    std::optional<int64_t> MissingSeatId() const;
+
+  private:
+    int64_t count_ = 0;
+    int64_t lowest_ = std::numeric_limits<int64_t>::max();
+    int64_t highest_ = std::numeric_limits<int64_t>::min();
+    int64_t xor_of_ids_ = 0;
+};
+
+// Decodes every booking in one pass without keeping the seat IDs.
+SeatIdSummary SummariseSeatIds(
+    std::string_view input, PlaneShape shape = {}, Validation validation = Validation::STRICT);
+SeatIdSummary SummariseSeatIdsFile(
+    const std::string& file_path, PlaneShape shape = {}, Validation validation = Validation::STRICT);
+
+// Reads a booking as the binary number it is, with B and R as ones.
+int64_t GetSeatIdQuickly(std::string_view booking);
+
+// Reads a single booking for the given plane, throwing if it's malformed.
+int64_t DecodeSeatId(std::string_view booking, PlaneShape shape = {});
+
+int GetHighestSeatId(const std::vector<int>& seat_ids);
+
+// Finds the one gap in an otherwise contiguous run of seat IDs, in any order.
+int GetMissingSeatId(const std::vector<int>& seat_ids);
+
+}  // namespace day05
+
+#endif  // AOC_2020_05_BOARDING_PASS_H_
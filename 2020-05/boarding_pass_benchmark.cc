@@ -0,0 +1,90 @@
+#include <string>
+#include <vector>
+
+#include "../common/microbench.h"
+#include "boarding_pass.h"
+
+namespace day05 {
+namespace {
+
+// The shipped bookings repeated range(0) times.
+std::string MakeInput(const BenchmarkState& state) {
+    return RepeatLines(ReadShippedInput("2020-05/data"), state.range(0));
+}
+
+void BM_DecodeSeatIds(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(DecodeSeatIds(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_DecodeSeatIds)->Args({1, 10, 1000});
+
+// Decoding alone, without checking the lines.
+void BM_DecodeSeatIdsTrusted(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(DecodeSeatIds(input, {}, Validation::TRUSTED));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_DecodeSeatIdsTrusted)->Args({1, 10, 1000});
+
+void BM_GetHighestSeatId(BenchmarkState& state) {
+    const std::vector<int> seat_ids = DecodeSeatIds(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(GetHighestSeatId(seat_ids));
+    }
+    state.SetItemsProcessed(state.iterations() * seat_ids.size());
+}
+MICROBENCHMARK(BM_GetHighestSeatId)->Args({1, 10, 1000});
+
+// Both answers in one pass, without keeping the seat IDs.
+void BM_SummariseSeatIds(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(SummariseSeatIds(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_SummariseSeatIds)->Args({1, 10, 1000});
+
+// The shipped bookings written with 0 and 1, a shape without fixed tables.
+void BM_SummariseSeatIdsRuntimeShape(BenchmarkState& state) {
+    std::string input = MakeInput(state);
+    for (char& c : input) {
+        if (c == 'F' || c == 'L') c = '0';
+        if (c == 'B' || c == 'R') c = '1';
+    }
+    const PlaneShape shape = {7, 3, {'0', '1'}, {'0', '1'}};
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(SummariseSeatIds(input, shape));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_SummariseSeatIdsRuntimeShape)->Args({1, 10, 1000});
+
+// A plane of 2^16 rows of 2^6 seats, every seat but one taken. Its passes
+// take two vector loads each.
+void BM_SummariseSeatIdsLargePlane(BenchmarkState& state) {
+    const PlaneShape shape = {16, 6};
+    std::string input;
+    for (int64_t seat_id = 0; seat_id < (int64_t{1} << shape.bits()); ++seat_id) {
+        if (seat_id == 12345) continue;
+        for (int bit = shape.bits() - 1; bit >= 0; --bit) {
+            const bool set = (seat_id >> bit) & 1;
+            input += bit >= shape.column_bits ? (set ? 'B' : 'F') : (set ? 'R' : 'L');
+        }
+        input += '\n';
+    }
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(SummariseSeatIds(input, shape));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_SummariseSeatIdsLargePlane)->Args({1});
+
+}
+
+}  // namespace day05
@@ -1,72 +1,43 @@
-#include <fstream>
 #include <iostream>
-#include <numeric>
 #include <string>
-#include <unordered_set>
+#include <string_view>
 #include <vector>
 
-typedef std::vector<std::string> GroupDeclaration;
+#include "customs_forms.h"
 
-std::vector<GroupDeclaration> ParseCustomsDeclarations(const std::string& file_path) {
-    std::ifstream infile(file_path);
-    std::string line;
-    GroupDeclaration current_declaration;
-    std::vector<GroupDeclaration> results;
 
-    while (std::getline(infile, line)) {
-        if (line.empty()) {
-            results.push_back(current_declaration);
-            current_declaration = {};
+int main(int argc, char* argv[]) {
+    // Each --at-least=<n> also sums the questions answered by at least n people
+    // in each group, all in the same pass over the input.
+    std::vector<day06::AnswerThreshold> extra_thresholds;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.rfind("--at-least=", 0) == 0) {
+            extra_thresholds.push_back(day06::AnsweredByAtLeast(std::stoi(std::string(arg.substr(11)))));
         } else {
-            current_declaration.push_back(line);
-        }
-    }
-
-    results.push_back(current_declaration);
-
-    return results;
-}
-
-std::unordered_set<char> GetAsSet(const std::string& answers) {
-    return std::unordered_set<char>(answers.begin(), answers.end());
-}
-
-template<typename T>
-std::unordered_set<T> SetUnion(const std::unordered_set<T>& first, const std::unordered_set<T>& second) {
-    std::unordered_set<T> result;
-
-    for (const T& element : first) {
-        auto search = second.find(element);
-        if (search != second.end()) {
-            result.insert(element);
+            positional.push_back(argv[i]);
         }
     }
 
-    return result;
-}
-
-int CountUnanimouslyAnsweredQuestions(const GroupDeclaration& declaration) {
-    std::unordered_set<char> unanimous_answers = std::accumulate(
-        std::next(declaration.begin()), declaration.end(),
-        GetAsSet(declaration.at(0)),
-        [](std::unordered_set<char> total, const std::string& current) { return SetUnion(total, GetAsSet(current)); } );
-    return unanimous_answers.size();
-}
-
-int GetSumOfUnanimouslyAnsweredQuestions(const std::vector<GroupDeclaration>& declarations) {
-    return std::accumulate(
-        std::next(declarations.begin()), declarations.end(),
-        CountUnanimouslyAnsweredQuestions(declarations.at(0)),
-        [](int total, const GroupDeclaration& current) { return total + CountUnanimouslyAnsweredQuestions(current); });
-}
-
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
+    if (positional.empty()) {
         std::cout << "Must pass a file name to parse!";
         return 1;
     }
 
-    std::vector<GroupDeclaration> declarations = ParseCustomsDeclarations(std::string(argv[1]));
-    int sum_of_answers = GetSumOfUnanimouslyAnsweredQuestions(declarations);
-    std::cout << "Sum of questions answered by all groups: " << sum_of_answers << std::endl;
+    if (extra_thresholds.empty()) {
+        std::vector<day06::GroupAnswers> groups = day06::ParseCustomsDeclarationsFile(positional[0]);
+        long long sum_of_answers = day06::GetSumOfUnanimouslyAnsweredQuestions(groups);
+        std::cout << "Sum of questions answered by all groups: " << sum_of_answers << std::endl;
+        return 0;
+    }
+
+    std::vector<day06::AnswerThreshold> thresholds = {day06::kAnsweredByEveryone};
+    thresholds.insert(thresholds.end(), extra_thresholds.begin(), extra_thresholds.end());
+    const day06::DeclarationStatistics statistics = day06::AggregateCustomsDeclarationsFile(positional[0], thresholds);
+    std::cout << "Sum of questions answered by all groups: " << statistics.thresholds[0].total() << std::endl;
+    for (size_t i = 1; i < thresholds.size(); ++i) {
+        std::cout << "Sum of questions answered by at least " << thresholds[i].min_people
+                  << " people: " << statistics.thresholds[i].total() << std::endl;
+    }
 }
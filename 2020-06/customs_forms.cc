@@ -0,0 +1,269 @@
+#include "customs_forms.h"
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day06 {
+
+namespace {
+
+std::runtime_error CreateBadAnswerException(std::string_view line) {
+    std::stringstream msg;
+    msg << "Answers should be letters from 'a' to 'z', but found '" << line << "'!";
+    return std::runtime_error(msg.str());
+}
+
+// Calls on_person with each person's answers and on_blank_line at every blank
+// line and at the end of the input, so once after each group and possibly
+// more often. One pass over the bytes rather than line by line, as lines are
+// short.
+template <typename OnPerson, typename OnBlankLine>
+void ReadDeclarations(std::string_view input, OnPerson&& on_person, OnBlankLine&& on_blank_line) {
+    AnswerMask person = 0;
+    bool line_empty = true;
+    bool valid = true;
+    size_t line_start = 0;
+
+    for (size_t i = 0; i < input.size(); ++i) {
+        const char c = input[i];
+        if (c == '\n') {
+            if (!valid) {
+                throw CreateBadAnswerException(input.substr(line_start, i - line_start));
+            }
+            if (!line_empty) {
+                on_person(person);
+            } else {
+                on_blank_line();
+            }
+            person = 0;
+            line_empty = true;
+            line_start = i + 1;
+        } else if (c != '\r') {
+            // Bad answers are caught as in ParseAnswers.
+            const unsigned question = static_cast<unsigned char>(c) - 'a';
+            valid &= question < kNumQuestions;
+            person |= AnswerMask{1} << (question % 32);
+            line_empty = false;
+        }
+    }
+
+    if (!valid) {
+        throw CreateBadAnswerException(input.substr(line_start));
+    }
+    if (!line_empty) {
+        on_person(person);
+    }
+    on_blank_line();
+}
+
+// A count per question. Counts below 2^kPlanes are kept bit-sliced: bit i of
+// planes_[p] is bit p of the count for question 'a' + i, so adding a mask
+// bumps every question in it at once by rippling carries up the planes. When
+// the planes are about to overflow they're emptied into plain per-question
+// counts, which only very large groups or totals ever need.
+template <int kPlanes>
+class QuestionCounter {
+  public:
+    void Add(AnswerMask answers) {
+        for (int plane = 0; plane < kPlanes; ++plane) {
+            const AnswerMask carry = planes_[plane] & answers;
+            planes_[plane] ^= answers;
+            answers = carry;
+        }
+        if (++sliced_adds_ == kMaxSlicedAdds) {
+            Spill();
+        }
+    }
+
+    // The questions with a count of at least 'min_count'.
+    AnswerMask AtLeast(long long min_count) const {
+        if (min_count <= 0) return kAllQuestions;
+        if (spilled_) {
+            AnswerMask result = 0;
+            for (int question = 0; question < kNumQuestions; ++question) {
+                result |= AnswerMask{Count(question) >= min_count} << question;
+            }
+            return result;
+        }
+        if (min_count > kMaxSlicedAdds) return 0;
+
+        // Compares every count with min_count a bit at a time from the top,
+        // keeping the questions found to be greater so far and those equal.
+        AnswerMask greater = 0;
+        AnswerMask equal = kAllQuestions;
+        for (int plane = kPlanes - 1; plane >= 0; --plane) {
+            const AnswerMask min_bit = AnswerMask{0} - ((min_count >> plane) & 1);
+            greater |= equal & planes_[plane] & ~min_bit;
+            equal &= ~(planes_[plane] ^ min_bit);
+        }
+        return greater | equal;
+    }
+
+    long long Count(int question) const {
+        long long count = spilled_ ? spilled_counts_[question] : 0;
+        for (int plane = 0; plane < kPlanes; ++plane) {
+            count += static_cast<long long>((planes_[plane] >> question) & 1) << plane;
+        }
+        return count;
+    }
+
+    void Clear() {
+        planes_ = {};
+        sliced_adds_ = 0;
+        if (spilled_) {
+            spilled_counts_ = {};
+            spilled_ = false;
+        }
+    }
+
+  private:
+    static constexpr int kMaxSlicedAdds = (1 << kPlanes) - 1;
+
+    void Spill() {
+        for (int question = 0; question < kNumQuestions; ++question) {
+            spilled_counts_[question] = Count(question);
+        }
+        planes_ = {};
+        sliced_adds_ = 0;
+        spilled_ = true;
+    }
+
+    std::array<AnswerMask, kPlanes> planes_ = {};
+    int sliced_adds_ = 0;
+    bool spilled_ = false;
+    std::array<long long, kNumQuestions> spilled_counts_ = {};
+};
+
+// Groups are mostly a handful of people, while totals grow with the input.
+typedef QuestionCounter<4> GroupCounter;
+typedef QuestionCounter<8> TotalCounter;
+
+std::runtime_error CreateBadThresholdException(const AnswerThreshold& threshold) {
+    std::stringstream msg;
+    msg << "Thresholds should be a number of people or everyone, but found " << threshold.min_people << "!";
+    return std::runtime_error(msg.str());
+}
+
+}
+
+AnswerMask ParseAnswers(std::string_view line) {
+    AnswerMask answers = 0;
+    bool valid = true;
+    for (char c : line) {
+        // Anything outside 'a' to 'z' comes out as a question of 26 or more,
+        // and is only reported once the whole line is done.
+        const unsigned question = static_cast<unsigned char>(c) - 'a';
+        valid &= question < kNumQuestions;
+        answers |= AnswerMask{1} << (question % 32);
+    }
+    if (!valid) {
+        throw CreateBadAnswerException(line);
+    }
+    return answers;
+}
+
+std::vector<GroupAnswers> ParseCustomsDeclarations(std::string_view input) {
+    std::vector<GroupAnswers> results;
+    // Groups take up a dozen or so bytes each in typical inputs, so this
+    // usually saves growing the vector over and over on large inputs.
+    results.reserve(input.size() / 16);
+    GroupAnswers current_group;
+
+    ReadDeclarations(
+        input,
+        [&](AnswerMask person) { current_group.Add(person); },
+        [&]() {
+            if (current_group.people > 0) {
+                results.push_back(current_group);
+                current_group = {};
+            }
+        });
+
+    return results;
+}
+
+std::vector<GroupAnswers> ParseCustomsDeclarationsFile(const std::string& file_path) {
+    InputView input(file_path);
+    return ParseCustomsDeclarations(input.contents());
+}
+
+long long GetSumOfAnsweredQuestions(const std::vector<GroupAnswers>& groups) {
+    long long total = 0;
+    for (const GroupAnswers& group : groups) {
+        total += __builtin_popcount(group.anyone);
+    }
+    return total;
+}
+
+long long GetSumOfUnanimouslyAnsweredQuestions(const std::vector<GroupAnswers>& groups) {
+    long long total = 0;
+    for (const GroupAnswers& group : groups) {
+        total += __builtin_popcount(group.everyone);
+    }
+    return total;
+}
+
+long long ThresholdTotals::total() const {
+    long long sum = 0;
+    for (long long groups : groups_per_question) {
+        sum += groups;
+    }
+    return sum;
+}
+
+DeclarationStatistics AggregateCustomsDeclarations(
+        std::string_view input, const std::vector<AnswerThreshold>& thresholds) {
+    for (const AnswerThreshold& threshold : thresholds) {
+        if (threshold.min_people < 0 && threshold.min_people != AnswerThreshold::kEveryone) {
+            throw CreateBadThresholdException(threshold);
+        }
+    }
+
+    DeclarationStatistics statistics;
+    GroupCounter group;
+    int group_size = 0;
+    TotalCounter people_per_question;
+    std::vector<TotalCounter> groups_per_question(thresholds.size());
+
+    ReadDeclarations(
+        input,
+        [&](AnswerMask person) {
+            group.Add(person);
+            people_per_question.Add(person);
+            ++group_size;
+        },
+        [&]() {
+            if (group_size == 0) return;
+            for (size_t i = 0; i < thresholds.size(); ++i) {
+                groups_per_question[i].Add(group.AtLeast(thresholds[i].MinPeople(group_size)));
+            }
+            ++statistics.groups;
+            statistics.people += group_size;
+            group.Clear();
+            group_size = 0;
+        });
+
+    statistics.thresholds.resize(thresholds.size());
+    for (int question = 0; question < kNumQuestions; ++question) {
+        statistics.people_per_question[question] = people_per_question.Count(question);
+        for (size_t i = 0; i < thresholds.size(); ++i) {
+            statistics.thresholds[i].groups_per_question[question] = groups_per_question[i].Count(question);
+        }
+    }
+    return statistics;
+}
+
+DeclarationStatistics AggregateCustomsDeclarationsFile(
+        const std::string& file_path, const std::vector<AnswerThreshold>& thresholds) {
+    InputView input(file_path);
+    return AggregateCustomsDeclarations(input.contents(), thresholds);
+}
+
+}  // namespace day06
@@ -0,0 +1,95 @@
+#ifndef AOC_2020_06_CUSTOMS_FORMS_H_
+#define AOC_2020_06_CUSTOMS_FORMS_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace day06 {
+
+// The questions someone answered, with question 'a' + i as bit i.
+typedef uint32_t AnswerMask;
+
+constexpr int kNumQuestions = 26;
+constexpr AnswerMask kAllQuestions = (AnswerMask{1} << kNumQuestions) - 1;
+
+// A group's declarations, reduced as they're read to the questions anyone
+// and everyone in it answered.
+struct GroupAnswers {
+    AnswerMask anyone = 0;
+    AnswerMask everyone = kAllQuestions;
+    int people = 0;
+
+    void Add(AnswerMask person) {
+        anyone |= person;
+        everyone &= person;
+        ++people;
+    }
+};
+
+// Reads one person's answers, a letter from 'a' to 'z' per question.
+AnswerMask ParseAnswers(std::string_view line);
+
+// Parses groups of declarations separated by blank lines, one line per person.
+// Empty groups are left out.
+std::vector<GroupAnswers> ParseCustomsDeclarations(std::string_view input);
+std::vector<GroupAnswers> ParseCustomsDeclarationsFile(const std::string& file_path);
+
+// Sums the questions anyone in each group answered.
+long long GetSumOfAnsweredQuestions(const std::vector<GroupAnswers>& groups);
+
+// Sums the questions everyone in each group answered.
+long long GetSumOfUnanimouslyAnsweredQuestions(const std::vector<GroupAnswers>& groups);
+
+// How many people in a group must have answered a question for it to count.
+struct AnswerThreshold {
+    // Stands for the size of whichever group is being looked at.
+    static constexpr int kEveryone = -1;
+
+    int min_people;
+
+    constexpr int MinPeople(int group_size) const {
+        return min_people == kEveryone ? group_size : min_people;
+    }
+};
+
+constexpr AnswerThreshold kAnsweredByAnyone{1};
+constexpr AnswerThreshold kAnsweredByEveryone{AnswerThreshold::kEveryone};
+
+constexpr AnswerThreshold AnsweredByAtLeast(int people) {
+    return AnswerThreshold{people};
+}
+
+// The questions meeting one threshold, over every group.
+struct ThresholdTotals {
+    // The number of groups in which question 'a' + i met the threshold.
+    std::array<long long, kNumQuestions> groups_per_question = {};
+
+    // Sums the questions meeting the threshold in each group.
+    long long total() const;
+};
+
+struct DeclarationStatistics {
+    long long groups = 0;
+    long long people = 0;
+    // The number of people who answered question 'a' + i.
+    std::array<long long, kNumQuestions> people_per_question = {};
+    // The totals for each threshold asked for, in the same order.
+    std::vector<ThresholdTotals> thresholds;
+};
+
+// Works out the statistics for any number of thresholds in one pass over the
+// declarations, without keeping the groups. Each group's per-question counts
+// are bit-sliced, so a person is added to all 26 counts at once and checking a
+// threshold takes a handful of mask operations per group.
+DeclarationStatistics AggregateCustomsDeclarations(
+    std::string_view input, const std::vector<AnswerThreshold>& thresholds);
+DeclarationStatistics AggregateCustomsDeclarationsFile(
+    const std::string& file_path, const std::vector<AnswerThreshold>& thresholds);
+
+}  // namespace day06
+
+#endif  // AOC_2020_06_CUSTOMS_FORMS_H_
@@ -0,0 +1,48 @@
+#include <string>
+#include <vector>
+
+#include "../common/microbench.h"
+#include "customs_forms.h"
+
+namespace day06 {
+namespace {
+
+// The shipped declarations repeated range(0) times, with a blank line between
+// copies so that groups don't run together.
+std::string MakeInput(const BenchmarkState& state) {
+    return RepeatLines(ReadShippedInput("2020-06/data") + "\n\n", state.range(0));
+}
+
+void BM_ParseCustomsDeclarations(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(ParseCustomsDeclarations(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_ParseCustomsDeclarations)->Args({1, 10, 1000});
+
+void BM_GetSumOfUnanimouslyAnsweredQuestions(BenchmarkState& state) {
+    const std::vector<GroupAnswers> groups = ParseCustomsDeclarations(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(GetSumOfUnanimouslyAnsweredQuestions(groups));
+    }
+    state.SetItemsProcessed(state.iterations() * groups.size());
+}
+MICROBENCHMARK(BM_GetSumOfUnanimouslyAnsweredQuestions)->Args({1, 10, 1000});
+
+// Every statistic the puzzle and its variations ask for, in one pass.
+void BM_AggregateCustomsDeclarations(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    const std::vector<AnswerThreshold> thresholds = {
+        kAnsweredByAnyone, kAnsweredByEveryone, AnsweredByAtLeast(2), AnsweredByAtLeast(3)};
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(AggregateCustomsDeclarations(input, thresholds));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_AggregateCustomsDeclarations)->Args({1, 10, 1000});
+
+}
+
+}  // namespace day06
@@ -0,0 +1,207 @@
+#include "luggage_graph.h"
+
+#include <exception>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day07 {
+
+namespace {
+
+const std::string_view kContain = " bags contain ";
+const std::string_view kNoOtherBags = "no other bags";
+
+std::runtime_error CreateMalformattedLineException(std::string_view line) {
+    std::stringstream error_msg;
+    error_msg << "Malformatted line: " << line;
+    return std::runtime_error(error_msg.str());
+}
+
+bool ConsumeSuffix(std::string_view& text, std::string_view suffix) {
+    if (text.size() < suffix.size() || text.substr(text.size() - suffix.size()) != suffix) {
+        return false;
+    }
+    text.remove_suffix(suffix.size());
+    return true;
+}
+
+// Adds the rules from one line, e.g. "light red bags contain 1 bright white
+// bag, 2 muted yellow bags.", to the graph being built.
+void ParseRule(std::string_view line, LuggageGraphBuilder* builder) {
+    const size_t contain = line.find(kContain);
+    if (contain == std::string_view::npos) {
+        throw CreateMalformattedLineException(line);
+    }
+    const BagId container = builder->Intern(line.substr(0, contain));
+
+    std::string_view contents = line.substr(contain + kContain.size());
+    ConsumeSuffix(contents, ".");
+    if (contents == kNoOtherBags) {
+        return;
+    }
+
+    FieldReader held_bags(contents, ',');
+    std::string_view held;
+    while (held_bags.Next(held)) {
+        if (!held.empty() && held.front() == ' ') {
+            held.remove_prefix(1);
+        }
+        int count;
+        const size_t count_length = ParseIntPrefix(held, count);
+        if (count_length == 0 || count_length >= held.size() || held[count_length] != ' ' ||
+            !(ConsumeSuffix(held, " bags") || ConsumeSuffix(held, " bag"))) {
+            throw CreateMalformattedLineException(line);
+        }
+        builder->BagContainsNBags(container, count, builder->Intern(held.substr(count_length + 1)));
+    }
+}
+
+}
+
+std::optional<BagId> LuggageGraph::FindBag(std::string_view name) const {
+    const auto bag = ids_.find(name);
+    if (bag == ids_.end()) {
+        return std::nullopt;
+    }
+    return bag->second;
+}
+
+BagId LuggageGraphBuilder::Intern(std::string_view name) {
+    if (const std::optional<BagId> bag = graph_.FindBag(name)) {
+        return *bag;
+    }
+    // The key has to point at the stored copy, as 'name' may not outlive the
+    // graph.
+    const BagId bag = static_cast<BagId>(graph_.names_.size());
+    graph_.names_.emplace_back(name);
+    graph_.ids_.emplace(graph_.names_.back(), bag);
+    return bag;
+}
+
+void LuggageGraphBuilder::BagContainsNBags(BagId container, int number, BagId child) {
+    rules_.push_back({container, {child, number}});
+}
+
+LuggageGraph LuggageGraphBuilder::Build() {
+    // Counting sorts of the rules by container and by held bag give each bag's
+    // edges in one block, keeping the order the rules were added in.
+    const size_t bags = graph_.names_.size();
+    graph_.held_offsets_.assign(bags + 1, 0);
+    graph_.holder_offsets_.assign(bags + 1, 0);
+    for (const Rule& rule : rules_) {
+        ++graph_.held_offsets_[rule.container + 1];
+        ++graph_.holder_offsets_[rule.held.bag + 1];
+    }
+    for (size_t bag = 0; bag < bags; ++bag) {
+        graph_.held_offsets_[bag + 1] += graph_.held_offsets_[bag];
+        graph_.holder_offsets_[bag + 1] += graph_.holder_offsets_[bag];
+    }
+
+    graph_.held_.resize(rules_.size());
+    graph_.holders_.resize(rules_.size());
+    std::vector<int> next_held(graph_.held_offsets_.begin(), graph_.held_offsets_.end() - 1);
+    std::vector<int> next_holder(graph_.holder_offsets_.begin(), graph_.holder_offsets_.end() - 1);
+    for (const Rule& rule : rules_) {
+        graph_.held_[next_held[rule.container]++] = rule.held;
+        graph_.holders_[next_holder[rule.held.bag]++] = rule.container;
+    }
+
+    rules_.clear();
+    LuggageGraph graph = std::move(graph_);
+    graph_ = LuggageGraph();
+    return graph;
+}
+
+LuggageGraph ParseLuggageGraph(std::string_view input) {
+    LuggageGraphBuilder builder;
+    LineReader lines(input);
+    std::string_view line;
+
+    while (lines.Next(line)) {
+        ParseRule(line, &builder);
+    }
+
+    return builder.Build();
+}
+
+LuggageGraph ParseLuggageGraphFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseLuggageGraph(input.contents());
+}
+
+int CountPossibleContainers(const std::string& bag_name, const LuggageGraph& graph) {
+    const std::optional<BagId> start = graph.FindBag(bag_name);
+    if (!start) {
+        return 0;
+    }
+
+    // Everything reachable along the holding edges, found with a stack rather
+    // than recursion so that long chains of bags can't overflow the call stack.
+    std::vector<bool> seen(graph.size(), false);
+    std::vector<BagId> to_visit = {*start};
+    seen[*start] = true;
+    int containers = 0;
+    while (!to_visit.empty()) {
+        const BagId bag = to_visit.back();
+        to_visit.pop_back();
+        for (const BagId holder : graph.HoldingBags(bag)) {
+            if (!seen[holder]) {
+                seen[holder] = true;
+                ++containers;
+                to_visit.push_back(holder);
+            }
+        }
+    }
+    return containers;
+}
+
+long long CountContainedBags(const std::string& bag_name, const LuggageGraph& graph) {
+    const std::optional<BagId> start = graph.FindBag(bag_name);
+    if (!start) {
+        return 0;
+    }
+
+    // Each bag's total, counting itself, is worked out once after those of
+    // every bag it holds. A bag met again while still in progress holds
+    // itself, so there's no finite answer.
+    const long long kInProgress = -1;
+    const long long kNotStarted = -2;
+    std::vector<long long> totals(graph.size(), kNotStarted);
+    std::vector<BagId> stack = {*start};
+    while (!stack.empty()) {
+        const BagId bag = stack.back();
+        if (totals[bag] == kNotStarted) {
+            totals[bag] = kInProgress;
+            for (const HeldBag& held : graph.HeldBags(bag)) {
+                if (totals[held.bag] == kInProgress) {
+                    std::stringstream error_msg;
+                    error_msg << "Bag '" << graph.BagName(held.bag) << "' ends up holding itself!";
+                    throw std::runtime_error(error_msg.str());
+                }
+                if (totals[held.bag] == kNotStarted) {
+                    stack.push_back(held.bag);
+                }
+            }
+            continue;
+        }
+
+        stack.pop_back();
+        if (totals[bag] != kInProgress) {
+            continue;
+        }
+        long long total = 1;
+        for (const HeldBag& held : graph.HeldBags(bag)) {
+            total += held.count * totals[held.bag];
+        }
+        totals[bag] = total;
+    }
+    return totals[*start] - 1;
+}
+
+}  // namespace day07
@@ -0,0 +1,115 @@
+#ifndef AOC_2020_07_LUGGAGE_GRAPH_H_
+#define AOC_2020_07_LUGGAGE_GRAPH_H_
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace day07 {
+
+// Bags are numbered from 0 in the order their names first turn up.
+typedef int BagId;
+
+// One kind of bag held directly inside another, 'count' times over.
+struct HeldBag {
+    BagId bag;
+    int count;
+};
+
+// A contiguous run of edges, for range-based for loops.
+template <typename T>
+class EdgeRange {
+  public:
+    EdgeRange(const T* begin, const T* end) : begin_(begin), end_(end) {}
+
+    const T* begin() const { return begin_; }
+    const T* end() const { return end_; }
+    size_t size() const { return end_ - begin_; }
+
+  private:
+    const T* begin_;
+    const T* end_;
+};
+
+// The bag rules over dense ids, with the edges in both directions stored in
+// compressed sparse row form: the bags held by bag i are
+// held_[held_offsets_[i]..held_offsets_[i + 1]), and likewise for the bags
+// holding it. Built once by LuggageGraphBuilder and not changed afterwards.
+class LuggageGraph {
+  public:
+    // Moving keeps the names where they are, but a copy's keys would still
+    // point into the original's names, so copying isn't allowed.
+    LuggageGraph(const LuggageGraph&) = delete;
+    LuggageGraph& operator=(const LuggageGraph&) = delete;
+    LuggageGraph(LuggageGraph&&) = default;
+    LuggageGraph& operator=(LuggageGraph&&) = default;
+
+    size_t size() const { return names_.size(); }
+
+    // Returns the id of the bag with this name, or nothing if no rule
+    // mentions it.
+    std::optional<BagId> FindBag(std::string_view name) const;
+    const std::string& BagName(BagId bag) const { return names_[bag]; }
+
+    EdgeRange<HeldBag> HeldBags(BagId bag) const {
+        return {held_.data() + held_offsets_[bag], held_.data() + held_offsets_[bag + 1]};
+    }
+
+    EdgeRange<BagId> HoldingBags(BagId bag) const {
+        return {holders_.data() + holder_offsets_[bag], holders_.data() + holder_offsets_[bag + 1]};
+    }
+
+  private:
+    friend class LuggageGraphBuilder;
+
+    LuggageGraph() = default;
+
+    // The names never move once added, so the keys can point into them.
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, BagId> ids_;
+    std::vector<int> held_offsets_;
+    std::vector<HeldBag> held_;
+    std::vector<int> holder_offsets_;
+    std::vector<BagId> holders_;
+};
+
+// Collects rules one at a time, giving each new name the next id, and lays
+// them out as a LuggageGraph at the end.
+class LuggageGraphBuilder {
+  public:
+    // Returns the id for 'name', giving it the next one if it's new.
+    BagId Intern(std::string_view name);
+    void BagContainsNBags(BagId container, int number, BagId child);
+
+    // Hands over the finished graph, leaving the builder empty.
+    LuggageGraph Build();
+
+  private:
+    struct Rule {
+        BagId container;
+        HeldBag held;
+    };
+
+    LuggageGraph graph_;
+    std::vector<Rule> rules_;
+};
+
+
+// Parses rules like "light red bags contain 1 bright white bag, 2 muted yellow bags."
+LuggageGraph ParseLuggageGraph(std::string_view input);
+LuggageGraph ParseLuggageGraphFile(const std::string& filename);
+
+// Counts the bags that eventually hold at least one 'bag_name'.
+int CountPossibleContainers(const std::string& bag_name, const LuggageGraph& graph);
+
+// Counts the bags held, however deeply, inside one 'bag_name'.
+long long CountContainedBags(const std::string& bag_name, const LuggageGraph& graph);
+
+}  // namespace day07
+
+#endif  // AOC_2020_07_LUGGAGE_GRAPH_H_
@@ -0,0 +1,40 @@
+#include <string>
+
+#include "../common/microbench.h"
+#include "luggage_graph.h"
+
+namespace day07 {
+namespace {
+
+// Repeating the shipped rules only adds duplicate edges between the same bags,
+// which is enough to scale up parsing and building the graph.
+void BM_ParseLuggageGraph(BenchmarkState& state) {
+    const std::string input = RepeatLines(ReadShippedInput("2020-07/data"), state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(ParseLuggageGraph(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_ParseLuggageGraph)->Args({1, 10, 1000});
+
+void BM_CountPossibleContainers(BenchmarkState& state) {
+    const LuggageGraph graph = ParseLuggageGraph(ReadShippedInput("2020-07/data"));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountPossibleContainers("shiny gold", graph));
+    }
+    state.SetItemsProcessed(state.iterations() * graph.size());
+}
+MICROBENCHMARK(BM_CountPossibleContainers);
+
+void BM_CountContainedBags(BenchmarkState& state) {
+    const LuggageGraph graph = ParseLuggageGraph(ReadShippedInput("2020-07/data"));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountContainedBags("shiny gold", graph));
+    }
+    state.SetItemsProcessed(state.iterations() * graph.size());
+}
+MICROBENCHMARK(BM_CountContainedBags);
+
+}
+
+}  // namespace day07
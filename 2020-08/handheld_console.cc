@@ -0,0 +1,140 @@
+#include "handheld_console.h"
+
+#include <exception>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day08 {
+
+namespace {
+
+Command SwapNoopAndJump(Command command) {
+    if (command == Command::NOOP) {
+        return Command::JMP;
+    } else if (command == Command::JMP) {
+        return Command::NOOP;
+    } else {
+        throw std::runtime_error("Incorrect SwapNoopAndJump call");
+    }
+}
+
+Command ToCommand(std::string_view command_name) {
+    if (command_name == "nop") {
+        return Command::NOOP;
+    } else if (command_name == "acc") {
+        return Command::ACC;
+    } else if (command_name == "jmp") {
+        return Command::JMP;
+    } else {
+        std::stringstream error_msg;
+        error_msg << "Unrecognised command: " << command_name;
+        throw std::runtime_error(error_msg.str());
+    }
+}
+
+}
+
+void Interpreter::LoadProgram(std::vector<Instruction> instructions) {
+    instructions_ = instructions;
+    pc_ = 0;
+    acc_ = 0;
+    seen_instructions_ = {};
+}
+
+int Interpreter::Execute() {
+    while (pc_ < instructions_.size()) {
+        if (seen_instructions_.find(pc_) != seen_instructions_.end()) {
+            throw InfiniteLoopException(pc_, acc_);
+        }
+        seen_instructions_.insert(pc_);
+
+        Instruction instruction = instructions_.at(pc_);
+        switch(instruction.instruction) {
+            case Command::NOOP:
+                ++pc_;
+                break;
+            case Command::ACC:
+                ++pc_;
+                acc_ += instruction.argument;
+                break;
+            case Command::JMP:
+                pc_ += instruction.argument;
+                break;
+            default:
+                std::stringstream error_msg;
+                error_msg << "Unrecognised instruction: " << instruction.instruction;
+                throw std::runtime_error(error_msg.str());
+        }
+    }
+
+    return acc_;
+}
+
+std::vector<Instruction> ParseInstructions(std::string_view input) {
+    std::vector<Instruction> results;
+    Scanner scanner(input);
+
+    std::string_view command_name;
+    int argument;
+
+    while (scanner.NextToken(command_name) && scanner.NextInt(argument)) {
+        Command command = ToCommand(command_name);
+        Instruction instruction {command, argument};
+        results.push_back(instruction);
+    }
+
+    return results;
+}
+
+std::vector<Instruction> ParseInstructionsFile(const std::string& file_path) {
+    InputView input(file_path);
+    return ParseInstructions(input.contents());
+}
+
+int FindAccumulatorAtInfiniteLoop(const std::vector<Instruction>& program) {
+    Interpreter interpreter;
+    interpreter.LoadProgram(program);
+    try {
+        interpreter.Execute();
+    } catch (const InfiniteLoopException& e) {
+        return e.accumulator;
+    }
+    throw std::runtime_error("The program finished without looping!");
+}
+
+std::vector<std::vector<Instruction>> GetPossiblePrograms(const std::vector<Instruction>& canonical_program) {
+    std::vector<std::vector<Instruction>> results;
+    results.push_back(canonical_program);
+
+    for (int i = 0; i < canonical_program.size(); i++) {
+        const auto& [comm, arg] = canonical_program.at(i);
+
+        if (comm == Command::NOOP || comm == Command::JMP) {
+            Command replacement = SwapNoopAndJump(comm);
+            std::vector<Instruction> modification(canonical_program.begin(), canonical_program.end());
+            modification.at(i).instruction = replacement;
+            results.push_back(modification);
+        }
+    }
+
+    return results;
+}
+
+int FindReturnValueOfSuccessfulProgram(const std::vector<std::vector<Instruction>>& programs) {
+    for (const std::vector<Instruction>& program : programs) {
+        Interpreter interpreter;
+        interpreter.LoadProgram(program);
+        try {
+            return interpreter.Execute();
+        } catch (const InfiniteLoopException& e) {
+            continue;
+        }
+    }
+    throw std::runtime_error("None of the possible programs succeeded!");
+}
+
+}  // namespace day08
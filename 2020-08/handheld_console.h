@@ -0,0 +1,66 @@
+#ifndef AOC_2020_08_HANDHELD_CONSOLE_H_
+#define AOC_2020_08_HANDHELD_CONSOLE_H_
+
+#include <exception>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+
+namespace day08 {
+
+enum Command {
+    NOOP = 0,
+    ACC = 1,
+    JMP = 2,
+};
+
+
+struct Instruction {
+    Command instruction;
+    int argument;
+};
+
+
+// Thrown when an instruction is about to run a second time.
+struct InfiniteLoopException : public std::exception {
+    InfiniteLoopException(int line, int accumulator) : line(line), accumulator(accumulator) {}
+
+    int line;
+    int accumulator;
+};
+
+
+class Interpreter {
+  public:
+    void LoadProgram(std::vector<Instruction> instructions);
+
+    // Runs until the program counter moves past the end and returns the
+    // accumulator, or throws InfiniteLoopException.
+    int Execute();
+
+  private:
+    int pc_ = 0;
+    int acc_ = 0;
+    std::vector<Instruction> instructions_;
+    std::unordered_set<int> seen_instructions_;
+};
+
+
+// Parses one instruction per line, e.g. "jmp -4".
+std::vector<Instruction> ParseInstructions(std::string_view input);
+std::vector<Instruction> ParseInstructionsFile(const std::string& file_path);
+
+// Returns the accumulator just before the program repeats an instruction.
+int FindAccumulatorAtInfiniteLoop(const std::vector<Instruction>& program);
+
+// The program followed by every copy of it with one nop and jmp swapped.
+std::vector<std::vector<Instruction>> GetPossiblePrograms(const std::vector<Instruction>& canonical_program);
+
+// Returns the accumulator of the first program that runs to the end.
+int FindReturnValueOfSuccessfulProgram(const std::vector<std::vector<Instruction>>& programs);
+
+}  // namespace day08
+
+#endif  // AOC_2020_08_HANDHELD_CONSOLE_H_
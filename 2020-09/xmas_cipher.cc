@@ -0,0 +1,115 @@
+#include "xmas_cipher.h"
+
+#include <algorithm>
+#include <exception>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day09 {
+
+namespace {
+
+bool ContainsNumbersSummingTo(const std::vector<long long>& vec, long long value) {
+    int l = 0;
+    int r = vec.size() - 1;
+
+    for (long long sum = vec[l] + vec[r]; sum != value; sum = vec[l] + vec[r]) {
+        if (sum > value) {
+            r--;
+        } else {
+            l++;
+        }
+        // Check the indices haven't crossed.
+        if (l >= r) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<long long> FindContiguousNumbersWithSum(const std::vector<long long>& input, long long target) {
+    int l = 0;
+    int r = 0;
+    long long sum = input.at(0);
+
+    while ((sum != target || r - l < 1) && r < input.size()) {
+        if (sum < target) {
+            ++r;
+            sum += input.at(r);
+        } else if (sum > target) {
+            sum -= input.at(l);
+            ++l;
+        }
+        if (l > r) {
+            throw std::runtime_error("Indices crossed whilst finding contiguous numbers with sum!");
+        }
+    }
+
+    return std::vector<long long>(input.begin() + l, input.begin() + r + 1);
+}
+
+}
+
+std::vector<long long> ParseXmasNumbers(std::string_view input) {
+    std::vector<long long> result;
+    Scanner scanner(input);
+    long long current;
+
+    while (scanner.NextInt(current)) {
+        result.push_back(current);
+    }
+
+    return result;
+}
+
+std::vector<long long> ParseXmasNumbersFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseXmasNumbers(input.contents());
+}
+
+long long FindIncorrectNumber(const std::vector<long long>& input, int pre_length) {
+    std::queue<long long> recent_numbers;
+    std::vector<long long> sorted_recent_numbers;
+
+    for (long long current : input) {
+        if (recent_numbers.size() < pre_length) {
+            // Still processing the preamble.
+            recent_numbers.push(current);
+            sorted_recent_numbers.insert(
+                std::upper_bound(
+                    sorted_recent_numbers.begin(), sorted_recent_numbers.end(), current),
+                current);
+            continue;
+        }
+
+        if (!ContainsNumbersSummingTo(sorted_recent_numbers, current)) {
+            return current;
+        }
+
+        long long oldest = recent_numbers.front();
+        recent_numbers.pop();
+        sorted_recent_numbers.erase(
+            std::remove(sorted_recent_numbers.begin(), sorted_recent_numbers.end(), oldest),
+            sorted_recent_numbers.end());
+        recent_numbers.push(current);
+        sorted_recent_numbers.insert(
+            std::upper_bound(
+                sorted_recent_numbers.begin(), sorted_recent_numbers.end(), current),
+            current);
+    }
+
+    throw std::runtime_error("No incorrect number found in the input sequence!");
+}
+
+long long ComputeEncryptionWeakness(const std::vector<long long>& input, long long incorrect_number) {
+    std::vector<long long> contiguous_sum_range = FindContiguousNumbersWithSum(input, incorrect_number);
+    return *std::min_element(contiguous_sum_range.begin(), contiguous_sum_range.end())
+        + *std::max_element(contiguous_sum_range.begin(), contiguous_sum_range.end());
+}
+
+}  // namespace day09
@@ -0,0 +1,24 @@
+#ifndef AOC_2020_09_XMAS_CIPHER_H_
+#define AOC_2020_09_XMAS_CIPHER_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace day09 {
+
+std::vector<long long> ParseXmasNumbers(std::string_view input);
+std::vector<long long> ParseXmasNumbersFile(const std::string& filename);
+
+// Finds the first number after the preamble that isn't the sum of two of the
+// 'pre_length' numbers before it.
+long long FindIncorrectNumber(const std::vector<long long>& input, int pre_length);
+
+// Sums the smallest and largest numbers of the contiguous run adding up to
+// 'incorrect_number'.
+long long ComputeEncryptionWeakness(const std::vector<long long>& input, long long incorrect_number);
+
+}  // namespace day09
+
+#endif  // AOC_2020_09_XMAS_CIPHER_H_
@@ -0,0 +1,72 @@
+#include "joltage_adaptors.h"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day10 {
+
+std::vector<int> ParseAdaptorJoltages(std::string_view input) {
+    std::vector<int> joltages;
+    Scanner scanner(input);
+
+    int current_joltage;
+    while (scanner.NextInt(current_joltage)) {
+        joltages.push_back(current_joltage);
+    }
+
+    return joltages;
+}
+
+std::vector<int> ParseAdaptorJoltagesFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseAdaptorJoltages(input.contents());
+}
+
+int ComputeDifferenceProduct(std::vector<int> adaptor_joltages) {
+    std::sort(adaptor_joltages.begin(), adaptor_joltages.end());
+    int last_joltage = 0;
+    int unit_diffs = 0;
+    // There's always a three-jolt difference between the last adaptor and the device.
+    int three_diffs = 1;
+
+    for (const int joltage : adaptor_joltages) {
+        switch (joltage - last_joltage) {
+            case 1:
+                ++unit_diffs;
+                break;
+            case 3:
+                ++three_diffs;
+                break;
+            default:
+                continue;
+        }
+        last_joltage = joltage;
+    }
+
+    return unit_diffs * three_diffs;
+}
+
+long long FindNumberOfAdaptations(std::vector<int> adaptor_joltages) {
+    std::sort(adaptor_joltages.begin(), adaptor_joltages.end());
+    std::unordered_map<int, long long> ways_to_make_joltage;
+    ways_to_make_joltage[0] = 1;
+
+    for (int joltage : adaptor_joltages) {
+        long long ways_to_make_this_joltage = 0;
+        for(int diff = 1; diff <= 3; ++diff) {
+            if (ways_to_make_joltage.find(joltage - diff) != ways_to_make_joltage.end()) {
+                ways_to_make_this_joltage += ways_to_make_joltage[joltage - diff];
+            }
+        }
+        ways_to_make_joltage[joltage] = ways_to_make_this_joltage;
+    }
+
+    return ways_to_make_joltage[adaptor_joltages.at(adaptor_joltages.size() - 1)];
+}
+
+}  // namespace day10
@@ -0,0 +1,22 @@
+#ifndef AOC_2020_10_JOLTAGE_ADAPTORS_H_
+#define AOC_2020_10_JOLTAGE_ADAPTORS_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace day10 {
+
+std::vector<int> ParseAdaptorJoltages(std::string_view input);
+std::vector<int> ParseAdaptorJoltagesFile(const std::string& filename);
+
+// Multiplies the number of 1-jolt and 3-jolt steps in the full adaptor chain.
+int ComputeDifferenceProduct(std::vector<int> adaptor_joltages);
+
+// Counts the chains from the outlet to the highest adaptor.
+long long FindNumberOfAdaptations(std::vector<int> adaptor_joltages);
+
+}  // namespace day10
+
+#endif  // AOC_2020_10_JOLTAGE_ADAPTORS_H_
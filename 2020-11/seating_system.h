@@ -0,0 +1,60 @@
+#ifndef AOC_2020_11_SEATING_SYSTEM_H_
+#define AOC_2020_11_SEATING_SYSTEM_H_
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace day11 {
+
+constexpr int kNumDirections = 8;
+
+enum Direction {
+    UP = 0,
+    UPRIGHT = 1,
+    RIGHT = 2,
+    DOWNRIGHT = 3,
+    DOWN = 4,
+    DOWNLEFT = 5,
+    LEFT = 6,
+    UPLEFT = 7
+};
+
+
+enum TileType {
+    FLOOR = 0,
+    CHAIR = 1,
+    FULL = 2,
+};
+
+struct Tile {
+    Tile(TileType tile_type): type(tile_type) {}
+
+    TileType type;
+    // How far away the nearest chair is in each direction, indexed by
+    // Direction. Only filled in for rules that look past the floor.
+    std::array<int, kNumDirections> nearest_chair = {};
+};
+
+// How many occupied seats a person looks at, and how many make them move.
+struct SeatingRules {
+    // Look past floor to the first seat in each direction, not just next door.
+    bool line_of_sight;
+    int crowded;
+};
+
+constexpr SeatingRules kAdjacentSeatRules = {false, 4};
+constexpr SeatingRules kVisibleSeatRules = {true, 5};
+
+// Parses a layout of floor (.), empty seats (L) and occupied seats (#).
+std::vector<std::vector<Tile>> ParseGrid(std::string_view input);
+std::vector<std::vector<Tile>> ParseGridFile(const std::string& filename);
+
+// Runs the rules until nobody moves and counts the occupied seats.
+int SimulateToCompletionAndCountUnoccupiedSeats(std::vector<std::vector<Tile>> grid, const SeatingRules& rules);
+
+}  // namespace day11
+
+#endif  // AOC_2020_11_SEATING_SYSTEM_H_
@@ -0,0 +1,181 @@
+#include "ferry_navigation.h"
+
+#include <exception>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day12 {
+
+namespace {
+
+Direction RotateBy(Direction d, int angle) {
+    if (d == Direction::FORWARD) {
+        throw std::runtime_error("Cannot rotate the direction 'forward'!");
+    }
+    int n_turns = angle / 90;
+    int rotated = (static_cast<int>(d)  + n_turns) % 4;
+    // Fix negative rotation.
+    rotated = (rotated + 4) % 4;
+    return static_cast<Direction>(rotated);
+}
+
+std::pair<int, int> RotateWaypoint(int x, int y, int angle) {
+    int n_turns = (angle / 90) % 4;
+    // Fix negative rotation.
+    n_turns = (n_turns + 4) % 4;
+
+    for (int i = 0; i < n_turns; ++i) {
+        int tmp = x;
+        x = y;
+        y = -tmp;
+    }
+
+    return {x, y};
+}
+
+const std::unordered_map<Direction, std::pair<int, int>> kDirectionOffsets = {
+    {Direction::EAST, {1, 0}},
+    {Direction::SOUTH, {0, -1}},
+    {Direction::WEST, {-1, 0}},
+    {Direction::NORTH, {0, 1}}};
+
+const std::unordered_map<char, Instruction::Type> kInstructionTypeMap = {
+    {'N', Instruction::Type::NORTH},
+    {'S', Instruction::Type::SOUTH},
+    {'E', Instruction::Type::EAST},
+    {'W', Instruction::Type::WEST},
+    {'F', Instruction::Type::FORWARD},
+    {'L', Instruction::Type::LEFT},
+    {'R', Instruction::Type::RIGHT}};
+
+class Ferry {
+  public:
+    void Rotate(int angle) {
+        facing_ = RotateBy(facing_, angle);
+    }
+
+    void Move(Direction direction, int amount) {
+        if (direction == Direction::FORWARD) {
+            const auto& [dx, dy] = kDirectionOffsets.at(facing_);
+            x_ += dx * amount;
+            y_ += dy * amount;
+        } else {
+            const auto& [dx, dy] = kDirectionOffsets.at(direction);
+            x_ += dx * amount;
+            y_ += dy * amount;
+        }
+    }
+
+    std::pair<int, int> GetPosition() { return {x_, y_}; }
+
+  private:
+    int x_ = 0;
+    int y_ = 0;
+    Direction facing_ = Direction::EAST;
+};
+
+// As Ferry, but steered by a waypoint relative to the ship.
+class WaypointFerry {
+  public:
+    void Rotate(int angle) {
+        const auto [n_x, n_y] = RotateWaypoint(w_x_, w_y_, angle);
+        w_x_ = n_x;
+        w_y_ = n_y;
+    }
+
+    void Move(Direction direction, int amount) {
+        if (direction == Direction::FORWARD) {
+            // Move to the waypoint 'amount' times.
+            x_ += w_x_ * amount;
+            y_ += w_y_ * amount;
+        } else {
+            // Move the waypoint in the specified direction.
+            const auto& [dx, dy] = kDirectionOffsets.at(direction);
+            w_x_ += dx * amount;
+            w_y_ += dy * amount;
+        }
+    }
+
+    std::pair<int, int> GetPosition() { return {x_, y_}; }
+
+  private:
+    int x_ = 0;
+    int y_ = 0;
+    // Waypoint starts at 10 East, 1 North.
+    int w_x_ = 10;
+    int w_y_ = 1;
+};
+
+template <typename FerryType>
+std::pair<int, int> ExecuteInstructionsOnFerry(const std::vector<Instruction>& instructions) {
+    FerryType ferry;
+
+    for (const Instruction& instruction : instructions) {
+        switch(instruction.type) {
+            case Instruction::Type::EAST:
+                ferry.Move(Direction::EAST, instruction.arg);
+                break;
+            case Instruction::Type::SOUTH:
+                ferry.Move(Direction::SOUTH, instruction.arg);
+                break;
+            case Instruction::Type::WEST:
+                ferry.Move(Direction::WEST, instruction.arg);
+                break;
+            case Instruction::Type::NORTH:
+                ferry.Move(Direction::NORTH, instruction.arg);
+                break;
+            case Instruction::Type::FORWARD:
+                ferry.Move(Direction::FORWARD, instruction.arg);
+                break;
+            case Instruction::Type::LEFT:
+                ferry.Rotate(-instruction.arg);
+                break;
+            case Instruction::Type::RIGHT:
+                ferry.Rotate(instruction.arg);
+                break;
+        }
+    }
+
+    return ferry.GetPosition();
+}
+
+}
+
+std::vector<Instruction> ParseInstructions(std::string_view input) {
+    std::vector<Instruction> instructions;
+    Scanner scanner(input);
+
+    char instr_code;
+    int arg;
+    while (scanner.NextChar(instr_code) && scanner.NextInt(arg)) {
+        if (kInstructionTypeMap.find(instr_code) == kInstructionTypeMap.end()) {
+            std::stringstream estream;
+            estream << "Invalid instruction code: '" << instr_code << "'!";
+            throw std::runtime_error(estream.str());
+        }
+        instructions.emplace_back(kInstructionTypeMap.at(instr_code), arg);
+    }
+
+    return instructions;
+}
+
+std::vector<Instruction> ParseInstructionsFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseInstructions(input.contents());
+}
+
+std::pair<int, int> ExecuteInstructions(const std::vector<Instruction>& instructions) {
+    return ExecuteInstructionsOnFerry<Ferry>(instructions);
+}
+
+std::pair<int, int> ExecuteWaypointInstructions(const std::vector<Instruction>& instructions) {
+    return ExecuteInstructionsOnFerry<WaypointFerry>(instructions);
+}
+
+}  // namespace day12
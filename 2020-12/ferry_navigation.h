@@ -0,0 +1,51 @@
+#ifndef AOC_2020_12_FERRY_NAVIGATION_H_
+#define AOC_2020_12_FERRY_NAVIGATION_H_
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace day12 {
+
+enum Direction {
+    EAST = 0,
+    SOUTH = 1,
+    WEST = 2,
+    NORTH = 3,
+    FORWARD = 4,
+};
+
+struct Instruction {
+    enum Type {
+        EAST = 0,
+        SOUTH = 1,
+        WEST = 2,
+        NORTH = 3,
+        FORWARD = 4,
+        LEFT = 5,
+        RIGHT = 6,
+    };
+
+    Instruction(Type t, int a): type(t), arg(a) {}
+
+    Type type;
+    int arg;
+};
+
+
+// Parses one instruction per line, e.g. "F10" or "R90".
+std::vector<Instruction> ParseInstructions(std::string_view input);
+std::vector<Instruction> ParseInstructionsFile(const std::string& filename);
+
+// Returns where the ship ends up when the instructions steer it directly.
+std::pair<int, int> ExecuteInstructions(const std::vector<Instruction>& instructions);
+
+// Returns where the ship ends up when the instructions move a waypoint, which
+// the ship then travels towards.
+std::pair<int, int> ExecuteWaypointInstructions(const std::vector<Instruction>& instructions);
+
+}  // namespace day12
+
+#endif  // AOC_2020_12_FERRY_NAVIGATION_H_
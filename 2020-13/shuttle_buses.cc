@@ -0,0 +1,107 @@
+#include "shuttle_buses.h"
+
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day13 {
+
+namespace {
+
+int FindLeastFrequentBus(const std::vector<std::optional<int>>& buses) {
+    int least_frequent = -1;
+    int longest_wait = -1;
+
+    for (int i = 0; i < buses.size(); ++i) {
+        const auto& bus = buses.at(i);
+        if (bus.has_value() && *bus > longest_wait) {
+            longest_wait = *bus;
+            least_frequent = i;
+        }
+    }
+
+    return least_frequent;
+}
+
+bool BusesFormMagicalPatternAtTimestamp(const std::vector<std::optional<int>>& buses, long long timestamp) {
+    for (long long i = 0; i < buses.size(); ++i) {
+        const auto& cur_bus = buses.at(i);
+        if (cur_bus.has_value()) {
+            long long cur_bus_value = *cur_bus;
+            if (((timestamp + i) % cur_bus_value) != 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+}
+
+BusNotes ParseBuses(std::string_view input) {
+    LineReader lines(input);
+    std::string_view line;
+    lines.Next(line);
+    int departure_time = ParseInt(line);
+
+    std::vector<std::optional<int>> buses;
+    lines.Next(line);
+    FieldReader bus_strings(line, ',');
+    std::string_view bus_string;
+    while (bus_strings.Next(bus_string)) {
+        if (bus_string == "x") {
+            buses.push_back({});
+        } else {
+            buses.push_back(ParseInt(bus_string));
+        }
+    }
+
+    return {departure_time, buses};
+}
+
+BusNotes ParseBusesFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseBuses(input.contents());
+}
+
+std::pair<int, int> FindBestBusIdAndTimeToDeparture(int departure_time, const std::vector<std::optional<int>>& buses) {
+    int lowest_dist_to_next = std::numeric_limits<int>::max();
+    int best_bus = -1;
+
+    for (const auto& maybe_bus : buses) {
+        if (!maybe_bus.has_value()) continue;
+        const int bus = *maybe_bus;
+        int mod = departure_time % bus;
+        if (mod == 0) {
+            // We can't do better.
+            return {bus, 0};
+        } else {
+            int time_until = bus - mod;
+            if (time_until < lowest_dist_to_next) {
+                lowest_dist_to_next = time_until;
+                best_bus = bus;
+            }
+        }
+    }
+
+    return {best_bus, lowest_dist_to_next};
+}
+
+long long FindEarliestMagicTimestamp(const std::vector<std::optional<int>>& buses) {
+    int least_frequent_bus = FindLeastFrequentBus(buses);
+    int longest_gap = *buses.at(least_frequent_bus);
+
+    for (long long timestamp = longest_gap - least_frequent_bus; ; timestamp += longest_gap) {
+        if (BusesFormMagicalPatternAtTimestamp(buses, timestamp)) {
+            return timestamp;
+        }
+    }
+}
+
+}  // namespace day13
@@ -0,0 +1,31 @@
+#ifndef AOC_2020_13_SHUTTLE_BUSES_H_
+#define AOC_2020_13_SHUTTLE_BUSES_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace day13 {
+
+struct BusNotes {
+    int departure_time;
+    // Bus IDs in timetable order, with no value for each "x".
+    std::vector<std::optional<int>> buses;
+};
+
+BusNotes ParseBuses(std::string_view input);
+BusNotes ParseBusesFile(const std::string& filename);
+
+// Returns the first bus to leave at or after 'departure_time', and the wait for it.
+std::pair<int, int> FindBestBusIdAndTimeToDeparture(int departure_time, const std::vector<std::optional<int>>& buses);
+
+// Finds the first timestamp at which each bus leaves as many minutes later as
+// its position in the timetable.
+long long FindEarliestMagicTimestamp(const std::vector<std::optional<int>>& buses);
+
+}  // namespace day13
+
+#endif  // AOC_2020_13_SHUTTLE_BUSES_H_
@@ -0,0 +1,161 @@
+#include "docking_program.h"
+
+#include <exception>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day14 {
+
+namespace {
+
+const std::string kWriteValueRegex = R"(mem\[([0-9]+)\] = ([0-9]+))";
+
+std::runtime_error CreateInvalidMaskCharException(std::string_view mask, char bad_char) {
+    std::stringstream msg;
+    msg << "Mask '" << mask << "' contains invalid character '" << bad_char << "'!";
+    return std::runtime_error(msg.str());
+}
+
+SetMask ParseSetMask(std::string_view mask_value) {
+    long long mask = 0;
+    long long mask_overwrite = 0;
+
+    for (int i = 0; i < mask_value.size(); ++i) {
+        if (mask_value[i] == 'X') continue;
+
+        mask |= 1LL << (mask_value.size() - i - 1);
+
+        switch(mask_value[i]) {
+            case '1':
+                mask_overwrite |= 1LL << (mask_value.size() - i - 1);
+                break;
+            case '0':
+                // Value is already zero here.
+                break;
+            default:
+                throw CreateInvalidMaskCharException(mask_value, mask_value[i]);
+        }
+    }
+
+    return {mask, mask_overwrite, std::string(mask_value)};
+}
+
+WriteValue ParseWriteValue(std::string_view line) {
+    const std::regex instruction_regex(kWriteValueRegex);
+    std::match_results<std::string_view::const_iterator> match;
+
+    if (std::regex_match(line.begin(), line.end(), match, instruction_regex)) {
+        return {std::stoll(match[1]), std::stoll(match[2])};
+    } else {
+        std::stringstream msg;
+        msg << "Could not parse instruction: " << line;
+        throw std::runtime_error(msg.str());
+    }
+}
+
+std::vector<long long> ComputeWriteList(long long address, const std::string& mask) {
+    std::vector<long long> addresses = {address};
+
+    for (int i = 0; i < mask.size(); ++i) {
+        if (mask[i] == 'X') {
+            long long one_here = 1LL << (mask.size() - i - 1);
+            std::vector<long long> duplicated(addresses.begin(), addresses.end());
+            for (auto& addr : addresses) {
+                addr &= ~one_here;
+            }
+            for (auto& addr : duplicated) {
+                addr |= one_here;
+            }
+            addresses.insert(addresses.begin(), duplicated.begin(), duplicated.end());
+        } else if (mask[i] == '1') {
+            for (auto& addr : addresses) {
+                addr |= 1LL << (mask.size() - i - 1);
+            }
+        } else if (mask[i] != '0') {
+            throw CreateInvalidMaskCharException(mask, mask[i]);
+        }
+    }
+    return addresses;
+}
+
+}
+
+std::vector<Instruction> ParseInstructions(std::string_view input) {
+    std::vector<Instruction> result;
+    LineReader lines(input);
+
+    std::string_view line;
+    while (lines.Next(line)) {
+        if (line.rfind("mask = ", 0) == 0) {
+            result.push_back(ParseSetMask(line.substr(7)));
+        } else {
+            result.push_back(ParseWriteValue(line));
+        }
+    }
+
+    return result;
+}
+
+std::vector<Instruction> ParseInstructionsFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseInstructions(input.contents());
+}
+
+long long ExecuteAndComputeMemorySum(const std::vector<Instruction>& instructions) {
+    std::unordered_map<long long, long long> memory;
+    long long mask;
+    long long mask_overwrite;
+
+    for (const auto& instruction : instructions) {
+        if (std::holds_alternative<SetMask>(instruction)) {
+            SetMask set_mask = std::get<SetMask>(instruction);
+            mask = set_mask.mask;
+            mask_overwrite = set_mask.mask_overwrite;
+        } else if (std::holds_alternative<WriteValue>(instruction)) {
+            WriteValue write_value = std::get<WriteValue>(instruction);
+            long long value_to_write = (write_value.data & ~mask) + (mask_overwrite & mask);
+            memory[write_value.address] = value_to_write;
+        }
+    }
+
+    long long result = 0;
+    for (const auto& [addr, val] : memory) {
+        result += val;
+    }
+
+    return result;
+}
+
+long long ExecuteWithFloatingAddressesAndComputeMemorySum(const std::vector<Instruction>& instructions) {
+    std::unordered_map<long long, long long> memory;
+    std::string mask;
+
+    for (const auto& instruction : instructions) {
+        if (std::holds_alternative<SetMask>(instruction)) {
+            SetMask set_mask = std::get<SetMask>(instruction);
+            mask = set_mask.pattern;
+        } else if (std::holds_alternative<WriteValue>(instruction)) {
+            WriteValue write_value = std::get<WriteValue>(instruction);
+            std::vector<long long> write_list = ComputeWriteList(write_value.address, mask);
+            for (const auto& address : write_list) {
+                memory[address] = write_value.data;
+            }
+        }
+    }
+
+    long long result = 0;
+    for (const auto& [addr, val] : memory) {
+        result += val;
+    }
+
+    return result;
+}
+
+}  // namespace day14
@@ -0,0 +1,41 @@
+#ifndef AOC_2020_14_DOCKING_PROGRAM_H_
+#define AOC_2020_14_DOCKING_PROGRAM_H_
+
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+
+namespace day14 {
+
+struct SetMask {
+    // Bits the mask sets, and the values it sets them to.
+    long long mask;
+    long long mask_overwrite;
+    // The mask as written, floating bits (X) included.
+    std::string pattern;
+};
+
+struct WriteValue {
+    long long address;
+    long long data;
+};
+
+typedef std::variant<SetMask, WriteValue> Instruction;
+
+
+// Parses "mask = ..." and "mem[...] = ..." lines.
+std::vector<Instruction> ParseInstructions(std::string_view input);
+std::vector<Instruction> ParseInstructionsFile(const std::string& filename);
+
+// Runs the program with masks applied to values and sums the memory.
+long long ExecuteAndComputeMemorySum(const std::vector<Instruction>& instructions);
+
+// Runs the program with masks applied to addresses, writing to every address
+// the floating bits can make, and sums the memory.
+long long ExecuteWithFloatingAddressesAndComputeMemorySum(const std::vector<Instruction>& instructions);
+
+}  // namespace day14
+
+#endif  // AOC_2020_14_DOCKING_PROGRAM_H_
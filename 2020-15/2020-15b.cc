@@ -1,43 +1,8 @@
-#include <fstream>
 #include <iostream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
-
-std::vector<int> ParseNumbers(std::string filename) {
-    std::vector<int> results;
-    std::ifstream infile(filename);
-
-    std::string num;
-    while (std::getline(infile, num, ',')) {
-        results.push_back(std::stoi(num));
-    }
-
-    return results;
-}
-
-int FindNthNumber(std::vector<int> starting_nums, long long target) {
-    std::unordered_map<int, int> last_seen;
-    int next_num = starting_nums.at(0);
-
-    for (long long i = 0; i < target - 1; i++) {
-        if (i < starting_nums.size() - 1) {
-            last_seen[next_num] = i;
-            next_num = starting_nums.at(i + 1);
-        } else {
-            if (last_seen.find(next_num) != last_seen.end()) {
-                int when_seen = i - last_seen.at(next_num);
-                last_seen[next_num] = i;
-                next_num = when_seen;
-            } else {
-                last_seen[next_num] = i;
-                next_num = 0;
-            }
-        }
-    }    
-    return next_num;
-}
+#include "memory_game.h"
 
 
 int main(int argc, char* argv[]) {
@@ -46,7 +11,7 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    std::vector<int> starting_numbers = ParseNumbers(std::string(argv[1]));
-    int num_at_a_whole_lot = FindNthNumber(starting_numbers, 30000000);
+    std::vector<int> starting_numbers = day15::ParseNumbersFile(std::string(argv[1]));
+    int num_at_a_whole_lot = day15::FindNthNumber(starting_numbers, 30000000);
     std::cout << "30000000th number in the sequence: " << num_at_a_whole_lot << std::endl;
 }
\ No newline at end of file
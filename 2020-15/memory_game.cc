@@ -0,0 +1,54 @@
+#include "memory_game.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day15 {
+
+std::vector<int> ParseNumbers(std::string_view input) {
+    std::vector<int> results;
+    LineReader lines(input);
+    std::string_view line;
+    lines.Next(line);
+
+    FieldReader nums(line, ',');
+    std::string_view num;
+    while (nums.Next(num)) {
+        results.push_back(ParseInt(num));
+    }
+
+    return results;
+}
+
+std::vector<int> ParseNumbersFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseNumbers(input.contents());
+}
+
+int FindNthNumber(const std::vector<int>& starting_nums, long long target) {
+    std::unordered_map<int, int> last_seen;
+    int next_num = starting_nums.at(0);
+
+    for (long long i = 0; i < target - 1; i++) {
+        if (i < starting_nums.size() - 1) {
+            last_seen[next_num] = i;
+            next_num = starting_nums.at(i + 1);
+        } else {
+            if (last_seen.find(next_num) != last_seen.end()) {
+                int when_seen = i - last_seen.at(next_num);
+                last_seen[next_num] = i;
+                next_num = when_seen;
+            } else {
+                last_seen[next_num] = i;
+                next_num = 0;
+            }
+        }
+    }    
+    return next_num;
+}
+
+}  // namespace day15
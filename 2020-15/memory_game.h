@@ -0,0 +1,21 @@
+#ifndef AOC_2020_15_MEMORY_GAME_H_
+#define AOC_2020_15_MEMORY_GAME_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace day15 {
+
+// Parses the comma-separated starting numbers on the first line.
+std::vector<int> ParseNumbers(std::string_view input);
+std::vector<int> ParseNumbersFile(const std::string& filename);
+
+// Plays the memory game from the given starting numbers and returns the
+// number spoken on turn 'target'.
+int FindNthNumber(const std::vector<int>& starting_nums, long long target);
+
+}  // namespace day15
+
+#endif  // AOC_2020_15_MEMORY_GAME_H_
@@ -0,0 +1,32 @@
+#include <string>
+#include <vector>
+
+#include "../common/microbench.h"
+#include "memory_game.h"
+
+namespace day15 {
+namespace {
+
+// The input is a handful of starting numbers, so scale the number of turns
+// played instead: range(0) times part a's 2020.
+void BM_FindNthNumber(BenchmarkState& state) {
+    const std::vector<int> starting_numbers = ParseNumbers(ReadShippedInput("2020-15/data"));
+    const long long turns = 2020 * state.range(0);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(FindNthNumber(starting_numbers, turns));
+    }
+    state.SetItemsProcessed(state.iterations() * turns);
+}
+MICROBENCHMARK(BM_FindNthNumber)->Args({1, 10, 1000});
+
+void BM_ParseNumbers(BenchmarkState& state) {
+    const std::string input = ReadShippedInput("2020-15/data");
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(ParseNumbers(input));
+    }
+}
+MICROBENCHMARK(BM_ParseNumbers);
+
+}
+
+}  // namespace day15
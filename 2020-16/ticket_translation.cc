@@ -0,0 +1,260 @@
+#include "ticket_translation.h"
+
+#include <algorithm>
+#include <exception>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day16 {
+
+namespace {
+
+const std::string kConstraintRegex = R"((.+): ([0-9]+)-([0-9]+) or ([0-9]+)-([0-9]+))";
+
+std::unordered_map<std::string, Constraint> ParseConstraints(const std::vector<std::string_view>& constraints) {
+    std::unordered_map<std::string, Constraint> results;
+    std::regex re(kConstraintRegex);
+    std::match_results<std::string_view::const_iterator> match;
+
+    for (const auto& constraint_string : constraints) {
+        if (std::regex_match(constraint_string.begin(), constraint_string.end(), match, re)) {
+            results[match[1]] = Constraint{std::stoi(match[2]), std::stoi(match[3]), std::stoi(match[4]), std::stoi(match[5])};
+        }
+    }
+    return results;
+}
+
+std::vector<int> ParseTicket(std::string_view ticket) {
+    std::vector<int> results;
+    FieldReader items(ticket, ',');
+    std::string_view current_item;
+
+    while (items.Next(current_item)) {
+        results.push_back(ParseInt(current_item));
+    }
+
+    return results;
+}
+
+bool ValueMeetsConstraint(const int value, const Constraint& constraint) {
+    return value >= constraint.l && value <= constraint.r && !(value > constraint.ex_l && value < constraint.ex_r);
+}
+
+int CountScanErrors(const std::vector<int>& ticket, const std::vector<Constraint>& constraints) {
+    int errors = 0;
+
+    for (const int value : ticket) {
+        auto found = std::find_if(
+            constraints.begin(), constraints.end(),
+            [&value](const Constraint& c) {
+                return ValueMeetsConstraint(value, c);
+            });
+        if (found == constraints.end()) {
+            errors += value;
+        }
+    }
+
+    return errors;
+}
+
+bool ContainsErrors(const std::vector<int>& ticket, const std::vector<Constraint>& constraints) {
+    return std::any_of(
+        ticket.begin(), ticket.end(),
+        [&constraints](const int value) {
+            return std::none_of(
+                constraints.begin(), constraints.end(),
+                [&value](const Constraint& c) { return ValueMeetsConstraint(value, c); });
+        });
+}
+
+std::vector<Constraint> ConstraintsList(const ProblemData& problem_data) {
+    std::vector<Constraint> result;
+
+    for (const auto& kv : problem_data.constraints) {
+        result.push_back(kv.second);
+    }
+
+    return result;
+}
+
+void FilterErroneousTickets(std::vector<std::vector<int>>& tickets, const std::vector<Constraint>& constraints) {
+    tickets.erase(
+        std::remove_if(
+            tickets.begin(), tickets.end(),
+            [&constraints](const std::vector<int>& ticket) {
+                return ContainsErrors(ticket, constraints);
+            }),
+        tickets.end());
+}
+
+std::unordered_set<std::string> GetMatchedConstraints(
+    const int value, const std::unordered_map<std::string, Constraint>& constraints) {
+    std::unordered_set<std::string> result;
+
+    for (const auto& [name, constraint] : constraints) {
+        if (ValueMeetsConstraint(value, constraint)) {
+            result.insert(name);
+        }
+    }
+
+    return result;
+}
+
+void FilterOptionsToMatchedConstraints(
+    std::unordered_set<std::string>& options, const std::unordered_set<std::string>& matched_constraints) {
+    for (auto iter = options.begin(); iter != options.end();) {
+        if (matched_constraints.find(*iter) != matched_constraints.end()) {
+            ++iter;
+        } else {
+            iter = options.erase(iter);
+        }
+    }
+}
+
+
+}
+
+ProblemData ParseProblemData(std::string_view input) {
+    LineReader lines(input);
+
+    // Parse constraints
+    std::vector<std::string_view> constraint_lines;
+    std::string_view constraint_line;
+    while (lines.Next(constraint_line) && !constraint_line.empty()) {
+        constraint_lines.push_back(constraint_line);
+    }
+    auto constraints = ParseConstraints(constraint_lines);
+
+    // Parse my ticket
+    std::string_view ticket_header;
+    std::string_view ticket_content;
+    lines.Next(ticket_header);
+    lines.Next(ticket_content);
+    if (ticket_header != "your ticket:") {
+        std::stringstream msg;
+        msg << "Expected 'your ticket' header but found '" << ticket_header << "'!";
+        throw std::runtime_error(msg.str());
+    }
+    auto my_ticket = ParseTicket(ticket_content);
+
+    // Parse nearby tickets
+    std::vector<std::vector<int>> near_tickets;
+    // Ignore blank line.
+    lines.Next(ticket_header);
+    lines.Next(ticket_header);
+    if (ticket_header != "nearby tickets:") {
+        std::stringstream msg;
+        msg << "Expected 'nearby tickets' header but found '" << ticket_header << "'!";
+        throw std::runtime_error(msg.str());
+    }
+    while (lines.Next(ticket_content)) {
+        near_tickets.push_back(ParseTicket(ticket_content));
+    }
+
+    return {constraints, my_ticket, near_tickets};
+}
+
+ProblemData ParseProblemDataFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseProblemData(input.contents());
+}
+
+int ComputeScanErrorRate(const ProblemData& data) {
+    int result = 0;
+
+    std::vector<Constraint> constraints;
+    constraints.reserve(data.constraints.size());
+    for (const auto& kv : data.constraints) {
+        constraints.push_back(kv.second);
+    }
+
+    for (const auto& ticket: data.near_tickets) {
+        result += CountScanErrors(ticket, constraints);
+    }
+
+    return result;
+}
+
+std::vector<std::string> GetOrderedFieldNames(const ProblemData& data) {
+    std::unordered_map<int, std::unordered_set<std::string>> options;
+    std::vector<std::vector<int>> tickets(data.near_tickets.begin(), data.near_tickets.end());
+    tickets.push_back(data.my_ticket);
+    std::vector<std::string> labels;
+
+    for (const auto& kv: data.constraints) {
+        labels.push_back(kv.first);
+    }
+
+    for (int i = 0; i < labels.size(); i++) {
+        options[i] = std::unordered_set<std::string>(labels.begin(), labels.end());
+    }
+
+    for (const auto& ticket : tickets) {
+        for (int i = 0; i < ticket.size(); ++i) {
+            const auto matched_constraints = GetMatchedConstraints(ticket.at(i), data.constraints);
+            FilterOptionsToMatchedConstraints(options.at(i), matched_constraints);
+        }
+    }
+
+    // Prepare a result vector mapping each index to the empty string.
+    std::vector<std::string> result;
+    for (int i = 0; i < labels.size(); i++) {
+        result.push_back("");
+    }
+
+    while (!options.empty()) {
+        int unambiguous_key = -1;
+        // Pick an options entry that has an unambiguous mapping: only one option left for this index.
+        for (const auto& [key, possibilities] : options) {
+            if (possibilities.size() == 1) {
+                unambiguous_key = key;
+                break;
+            }
+        }
+        if (unambiguous_key == -1) {
+            // Just in case we already found the mappings we need, list all the options.
+            std::stringstream msg;
+            msg << "Couldn't find a certain mapping! Options:" << std::endl;
+            for (const auto& [key, set] : options) {
+                msg << key << ": ";
+                for (const auto& option : set) {
+                    msg << option << ", ";
+                }
+                msg << std::endl;
+            }
+            throw std::runtime_error(msg.str());
+        }
+        // Apply the only option for this index and remove its entry from the options map.
+        std::string label = *(options.at(unambiguous_key).begin());
+        result.at(unambiguous_key) = label;
+        options.erase(unambiguous_key);
+        // Remove this option from all the other option entries.
+        for (auto& [key, option] : options) {
+            option.erase(label);
+        }
+    }
+
+    return result;
+}
+
+long long MultiplyDepartureFields(ProblemData data) {
+    FilterErroneousTickets(data.near_tickets, ConstraintsList(data));
+    std::vector<std::string> ordered_field_names = GetOrderedFieldNames(data);
+
+    long long multiplication = 1LL;
+    for (long long i = 0; i < ordered_field_names.size(); ++i) {
+        if (ordered_field_names.at(i).rfind("departure", 0) == 0) {
+            multiplication *= data.my_ticket.at(i);
+        }
+    }
+    return multiplication;
+}
+
+}  // namespace day16
@@ -0,0 +1,43 @@
+#ifndef AOC_2020_16_TICKET_TRANSLATION_H_
+#define AOC_2020_16_TICKET_TRANSLATION_H_
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace day16 {
+
+// Represents a constraint of the form "l-ex_l or ex_r-r"
+struct Constraint {
+    int l;  // Left side
+    int ex_l;  // Left side of the exclusion zone in the middle
+    int ex_r;  // Right side of the exclusion zone in the middle
+    int r;  // Right side
+};
+
+struct ProblemData {
+    std::unordered_map<std::string, Constraint> constraints;
+    std::vector<int> my_ticket;
+    std::vector<std::vector<int>> near_tickets;
+};
+
+
+// Parses the field rules, my ticket and the nearby tickets.
+ProblemData ParseProblemData(std::string_view input);
+ProblemData ParseProblemDataFile(const std::string& filename);
+
+// Sums the nearby ticket values that fit no field at all.
+int ComputeScanErrorRate(const ProblemData& data);
+
+// Works out which field each ticket position holds, using only tickets
+// without errors.
+std::vector<std::string> GetOrderedFieldNames(const ProblemData& data);
+
+// Multiplies the values on my ticket of the fields starting "departure".
+long long MultiplyDepartureFields(ProblemData data);
+
+}  // namespace day16
+
+#endif  // AOC_2020_16_TICKET_TRANSLATION_H_
@@ -0,0 +1,442 @@
+#include "conway_cubes.h"
+
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "../common/input_view.h"
+#include "../common/thread_pool.h"
+
+namespace day17 {
+
+namespace {
+
+std::vector<std::tuple<int, int, int>> GetNeighbours(int x, int y, int z) {
+    std::vector<std::tuple<int, int, int>> result;
+
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dz = -1; dz <= 1; ++dz) {
+                if (!(dx == 0 && dy == 0 && dz == 0)) {
+                    result.push_back({x + dx, y + dy, z + dz});
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+std::vector<std::tuple<int, int, int, int>> GetNeighbours(int x, int y, int z, int w) {
+    std::vector<std::tuple<int, int, int, int>> result;
+
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dz = -1; dz <= 1; ++dz) {
+                for (int dw = -1; dw <= 1; ++dw) {
+                    if (!(dx == 0 && dy == 0 && dz == 0 && dw == 0)) {
+                        result.push_back({x + dx, y + dy, z + dz, w + dw});
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+bool InBounds(int value, Bounds bounds) {
+    return value >= bounds.low && value <= bounds.high;
+}
+
+std::runtime_error CreateUnrecognisedCharacterException(char c) {
+    std::stringstream msg;
+    msg << "Unrecognised character in input data: " << c;
+    return std::runtime_error(msg.str());
+}
+
+std::vector<std::vector<char>> ParseDataGrid(std::string_view input) {
+    std::vector<std::vector<char>> data_grid;
+    LineReader lines(input);
+
+    std::string_view line;
+    while (lines.Next(line)) {
+        data_grid.emplace_back(line.begin(), line.end());
+    }
+
+    return data_grid;
+}
+
+}
+
+
+ConwayCube::ConwayCube(Bounds b_x, Bounds b_y, Bounds b_z)
+    : x_bounds_(b_x), y_bounds_(b_y), z_bounds_(b_z) {
+    InitialiseZeroCube();
+}
+
+bool ConwayCube::IsFilled(int x, int y, int z) const {
+    if (!(InBounds(x, x_bounds_) && InBounds(y, y_bounds_) && InBounds(z, z_bounds_))) {
+        return false;
+    }
+    int real_x = x - x_bounds_.low;
+    int real_y = y - y_bounds_.low;
+    int real_z = z - z_bounds_.low;
+
+    return cube_.at(real_z).at(real_y).at(real_x);
+}
+
+void ConwayCube::SetValue(int x, int y, int z, bool value) {
+    if (!(InBounds(x, x_bounds_) && InBounds(y, y_bounds_) && InBounds(z, z_bounds_))) {
+        std::stringstream msg;
+        msg << "Position out of bounds: (" << x << ", " << y << ", " << z << ")!";
+        throw std::runtime_error(msg.str());
+    }
+
+    if (value) {
+        x_bounds_.NotifyValueUsed(x);
+        y_bounds_.NotifyValueUsed(y);
+        z_bounds_.NotifyValueUsed(z);
+    }
+
+    int real_x = x - x_bounds_.low;
+    int real_y = y - y_bounds_.low;
+    int real_z = z - z_bounds_.low;
+
+    cube_.at(real_z).at(real_y).at(real_x) = value;
+}
+
+int ConwayCube::CountNeighbours(int x, int y, int z) const {
+    auto neighbours = GetNeighbours(x, y, z);
+    int active_neighbours = 0;
+    for (const auto& [n_x, n_y, n_z] : neighbours) {
+        if (IsFilled(n_x, n_y, n_z)) {
+            ++active_neighbours;
+        }
+    }
+
+    return active_neighbours;
+}
+
+void ConwayCube::UpdateFromPreviousCube(const ConwayCube& previous) {
+    for (int z = z_bounds_.low; z <= z_bounds_.high; ++z) {
+        for (int y = y_bounds_.low; y <= y_bounds_.high; ++y) {
+            for (int x = x_bounds_.low; x <= x_bounds_.high; ++x) {
+                int active_neighbours = previous.CountNeighbours(x, y, z);
+
+                // If this voxel was previously filled...
+                if (previous.IsFilled(x, y, z)) {
+                    if (active_neighbours == 2 || active_neighbours == 3) {
+                        // Stay filled with 2 or 3 neighbours.
+                        SetValue(x, y, z, true);
+                    } else {
+                        // Unfill otherwise.
+                        SetValue(x, y, z, false);
+                    }
+                } else {
+                    // Otherise, fill if there are exactly three neighbours.
+                    if (active_neighbours == 3) {
+                        SetValue(x, y, z, true);
+                    }
+                }
+            }
+        }
+    }
+}
+
+int ConwayCube::CountActiveCubes() const {
+    int result = 0;
+
+    for (int z = 0; z < z_bounds_.Size(); ++z) {
+        for (int y = 0; y < y_bounds_.Size(); ++y) {
+            for (int x = 0; x < x_bounds_.Size(); ++x) {
+                if (cube_.at(z).at(y).at(x)) {
+                    ++result;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+void ConwayCube::DumpPlane(int plane) {
+    std::cout << "(" << x_bounds_.low << ", " << y_bounds_.low << ")" << std::endl;
+    for (const auto row : cube_.at(plane)) {
+        for (const auto col : row) {
+            if (col) {
+                std::cout << "#";
+            } else {
+                std::cout << ".";
+            }
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void ConwayCube::Dump() {
+    for (int z = 0; z < z_bounds_.Size(); ++z) {
+        std::cout << "-- z = " << z + z_bounds_.low << std::endl;
+        DumpPlane(z);
+    }
+    std::cout << std::endl << "--------------------" << std::endl << std::endl;
+}
+
+void ConwayCube::InitialiseZeroCube() {
+    cube_ = std::vector<std::vector<std::vector<bool>>>();
+    for (int z = 0; z < z_bounds_.Size(); ++z) {
+        std::vector<std::vector<bool>> plane;
+        for (int y = 0; y < y_bounds_.Size(); ++y) {
+            std::vector<bool> row;
+            for (int x = 0; x < x_bounds_.Size(); ++x) {
+                row.push_back(false);
+            }
+            plane.push_back(row);
+        }
+        cube_.push_back(plane);
+    }
+}
+
+ConwayHypercube::ConwayHypercube(Bounds b_x, Bounds b_y, Bounds b_z, Bounds b_w)
+    : x_bounds_(b_x), y_bounds_(b_y), z_bounds_(b_z), w_bounds_(b_w) {
+    InitialiseZeroCube();
+}
+
+bool ConwayHypercube::IsFilled(int x, int y, int z, int w) const {
+    if (!(InBounds(x, x_bounds_) && InBounds(y, y_bounds_)
+        && InBounds(z, z_bounds_) && InBounds(w, w_bounds_))) {
+        return false;
+    }
+    int real_x = x - x_bounds_.low;
+    int real_y = y - y_bounds_.low;
+    int real_z = z - z_bounds_.low;
+    int real_w = w - w_bounds_.low;
+
+    return cube_.at(real_w).at(real_z).at(real_y).at(real_x);
+}
+
+void ConwayHypercube::SetValue(int x, int y, int z, int w, bool value) {
+    if (!(InBounds(x, x_bounds_) && InBounds(y, y_bounds_)
+        && InBounds(z, z_bounds_) && InBounds(w, w_bounds_))) {
+        std::stringstream msg;
+        msg << "Position out of bounds: (" << x << ", " << y << ", " << z << ", " << w << ")!";
+        throw std::runtime_error(msg.str());
+    }
+
+    if (value) {
+        x_bounds_.NotifyValueUsed(x);
+        y_bounds_.NotifyValueUsed(y);
+        z_bounds_.NotifyValueUsed(z);
+        w_bounds_.NotifyValueUsed(w);
+    }
+
+    int real_x = x - x_bounds_.low;
+    int real_y = y - y_bounds_.low;
+    int real_z = z - z_bounds_.low;
+    int real_w = w - w_bounds_.low;
+
+    cube_.at(real_w).at(real_z).at(real_y).at(real_x) = value;
+}
+
+int ConwayHypercube::CountNeighbours(int x, int y, int z, int w) const {
+    auto neighbours = GetNeighbours(x, y, z, w);
+    int active_neighbours = 0;
+    for (const auto& [n_x, n_y, n_z, n_w] : neighbours) {
+        if (IsFilled(n_x, n_y, n_z, n_w)) {
+            ++active_neighbours;
+        }
+    }
+
+    return active_neighbours;
+}
+
+void ConwayHypercube::UpdateFromPreviousCube(const ConwayHypercube& previous, ThreadPool* pool) {
+    // Each w slice is worked out independently, but the cells are only set
+    // afterwards since SetValue also widens the bounds shared by every slice.
+    std::vector<std::vector<std::tuple<int, int, int>>> filled_by_slice(w_bounds_.Size());
+    ParallelFor(pool, w_bounds_.low, w_bounds_.high + 1, [&](int w) {
+        auto& filled = filled_by_slice[w - w_bounds_.low];
+        for (int z = z_bounds_.low; z <= z_bounds_.high; ++z) {
+            for (int y = y_bounds_.low; y <= y_bounds_.high; ++y) {
+                for (int x = x_bounds_.low; x <= x_bounds_.high; ++x) {
+                    int active_neighbours = previous.CountNeighbours(x, y, z, w);
+
+                    // Filled voxels stay filled with 2 or 3 neighbours; empty
+                    // ones fill with exactly three. Everything else is empty.
+                    if (active_neighbours == 3
+                        || (active_neighbours == 2 && previous.IsFilled(x, y, z, w))) {
+                        filled.emplace_back(x, y, z);
+                    }
+                }
+            }
+        }
+    });
+
+    for (int w = w_bounds_.low; w <= w_bounds_.high; ++w) {
+        for (const auto& [x, y, z] : filled_by_slice[w - w_bounds_.low]) {
+            SetValue(x, y, z, w, true);
+        }
+    }
+}
+
+int ConwayHypercube::CountActiveCubes() const {
+    int result = 0;
+
+    for (int w = 0; w < w_bounds_.Size(); ++w) {
+        for (int z = 0; z < z_bounds_.Size(); ++z) {
+            for (int y = 0; y < y_bounds_.Size(); ++y) {
+                for (int x = 0; x < x_bounds_.Size(); ++x) {
+                    if (cube_.at(w).at(z).at(y).at(x)) {
+                        ++result;
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+void ConwayHypercube::DumpPlane(int plane) {
+    std::cout << "(" << x_bounds_.low << ", " << y_bounds_.low << ")" << std::endl;
+    for (const auto row : cube_.at(0).at(plane)) {
+        for (const auto col : row) {
+            if (col) {
+                std::cout << "#";
+            } else {
+                std::cout << ".";
+            }
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void ConwayHypercube::Dump() {
+    for (int z = 0; z < z_bounds_.Size(); ++z) {
+        std::cout << "-- z = " << z + z_bounds_.low << std::endl;
+        DumpPlane(z);
+    }
+    std::cout << std::endl << "--------------------" << std::endl << std::endl;
+}
+
+void ConwayHypercube::InitialiseZeroCube() {
+    cube_ = std::vector<std::vector<std::vector<std::vector<bool>>>>();
+    for (int w = 0; w < w_bounds_.Size(); ++w) {
+        std::vector<std::vector<std::vector<bool>>> cube;
+        for (int z = 0; z < z_bounds_.Size(); ++z) {
+            std::vector<std::vector<bool>> plane;
+            for (int y = 0; y < y_bounds_.Size(); ++y) {
+                std::vector<bool> row;
+                for (int x = 0; x < x_bounds_.Size(); ++x) {
+                    row.push_back(false);
+                }
+                plane.push_back(row);
+            }
+            cube.push_back(plane);
+        }
+        cube_.push_back(cube);
+    }
+}
+
+ConwayCube ParseInitialCube(std::string_view input) {
+    std::vector<std::vector<char>> data_grid = ParseDataGrid(input);
+    const int width = data_grid.at(0).size();
+    const int height = data_grid.size();
+
+    ConwayCube cube({0, width - 1}, {0, height - 1}, {0, 0});
+
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) {
+            char c = data_grid.at(y).at(x);
+            switch(c) {
+                case '.':
+                    break;
+                case '#':
+                    cube.SetValue(x, y, 0, true);
+                    break;
+                default:
+                    throw CreateUnrecognisedCharacterException(c);
+            }
+        }
+    }
+
+    return cube;
+}
+
+ConwayCube ParseInitialCubeFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseInitialCube(input.contents());
+}
+
+ConwayHypercube ParseInitialHypercube(std::string_view input) {
+    std::vector<std::vector<char>> data_grid = ParseDataGrid(input);
+    const int width = data_grid.at(0).size();
+    const int height = data_grid.size();
+
+    ConwayHypercube cube({0, width - 1}, {0, height - 1}, {0, 0}, {0, 0});
+
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) {
+            char c = data_grid.at(y).at(x);
+            switch(c) {
+                case '.':
+                    break;
+                case '#':
+                    cube.SetValue(x, y, 0, 0, true);
+                    break;
+                default:
+                    throw CreateUnrecognisedCharacterException(c);
+            }
+        }
+    }
+
+    return cube;
+}
+
+ConwayHypercube ParseInitialHypercubeFile(const std::string& filename) {
+    InputView input(filename);
+    return ParseInitialHypercube(input.contents());
+}
+
+ConwayCube EvaluateOneCycle(const ConwayCube& current) {
+    Bounds new_x_bounds = current.GetXBounds().CreateMinimalEnclosingBounds();
+    Bounds new_y_bounds = current.GetYBounds().CreateMinimalEnclosingBounds();
+    Bounds new_z_bounds = current.GetZBounds().CreateMinimalEnclosingBounds();
+    ConwayCube new_cube(new_x_bounds, new_y_bounds, new_z_bounds);
+    new_cube.UpdateFromPreviousCube(current);
+    return new_cube;
+}
+
+int EvaluateSixCyclesAndCountActiveCubes(const ConwayCube& first_cube) {
+    ConwayCube current = EvaluateOneCycle(first_cube);
+    for (int i = 0; i < 5; ++i) {
+        current = EvaluateOneCycle(current);
+    }
+    return current.CountActiveCubes();
+}
+
+ConwayHypercube EvaluateOneCycle(const ConwayHypercube& current, ThreadPool* pool) {
+    Bounds new_x_bounds = current.GetXBounds().CreateMinimalEnclosingBounds();
+    Bounds new_y_bounds = current.GetYBounds().CreateMinimalEnclosingBounds();
+    Bounds new_z_bounds = current.GetZBounds().CreateMinimalEnclosingBounds();
+    Bounds new_w_bounds = current.GetWBounds().CreateMinimalEnclosingBounds();
+    ConwayHypercube new_cube(new_x_bounds, new_y_bounds, new_z_bounds, new_w_bounds);
+    new_cube.UpdateFromPreviousCube(current, pool);
+    return new_cube;
+}
+
+int EvaluateSixCyclesAndCountActiveCubes(const ConwayHypercube& first_cube, ThreadPool* pool) {
+    ConwayHypercube current = EvaluateOneCycle(first_cube, pool);
+    for (int i = 0; i < 5; ++i) {
+        current = EvaluateOneCycle(current, pool);
+    }
+    return current.CountActiveCubes();
+}
+
+}  // namespace day17
@@ -0,0 +1,112 @@
+#ifndef AOC_2020_17_CONWAY_CUBES_H_
+#define AOC_2020_17_CONWAY_CUBES_H_
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ThreadPool;
+
+
+namespace day17 {
+
+struct Bounds {
+    Bounds(int bottom, int top): low(bottom), low_used(0), high_used(0), high(top) {}
+
+    int Size() const { return (high + 1) - low; }
+
+    // When a value has been set to true, use this to update the low_used and high_used bounds to
+    // match.
+    void NotifyValueUsed(int value) {
+        low_used = std::min(low_used, value);
+        high_used = std::max(high_used, value);
+    }
+
+    // Returns a set of bounds just big enough to cover all values currently enclosed with one
+    // space of padding on each end.
+    Bounds CreateMinimalEnclosingBounds() const {
+        return {low_used - 1, high_used + 1};
+    }
+
+    int low;
+    int low_used;
+    int high_used;
+    int high;
+};
+
+
+// A window onto the infinite 3D grid of cubes, big enough to hold every active
+// one.
+class ConwayCube {
+  public:
+    ConwayCube(Bounds b_x, Bounds b_y, Bounds b_z);
+
+    Bounds GetXBounds() const { return x_bounds_; }
+    Bounds GetYBounds() const { return y_bounds_; }
+    Bounds GetZBounds() const { return z_bounds_; }
+
+    bool IsFilled(int x, int y, int z) const;
+    void SetValue(int x, int y, int z, bool value);
+    int CountNeighbours(int x, int y, int z) const;
+    void UpdateFromPreviousCube(const ConwayCube& previous);
+    int CountActiveCubes() const;
+
+    void DumpPlane(int plane);
+    void Dump();
+
+  private:
+    void InitialiseZeroCube();
+
+    std::vector<std::vector<std::vector<bool>>> cube_;
+    Bounds x_bounds_;
+    Bounds y_bounds_;
+    Bounds z_bounds_;
+};
+
+// As ConwayCube, but in four dimensions.
+class ConwayHypercube {
+  public:
+    ConwayHypercube(Bounds b_x, Bounds b_y, Bounds b_z, Bounds b_w);
+
+    Bounds GetXBounds() const { return x_bounds_; }
+    Bounds GetYBounds() const { return y_bounds_; }
+    Bounds GetZBounds() const { return z_bounds_; }
+    Bounds GetWBounds() const { return w_bounds_; }
+
+    bool IsFilled(int x, int y, int z, int w) const;
+    void SetValue(int x, int y, int z, int w, bool value);
+    int CountNeighbours(int x, int y, int z, int w) const;
+    // Works through the w slices on 'pool' if one is given.
+    void UpdateFromPreviousCube(const ConwayHypercube& previous, ThreadPool* pool = nullptr);
+    int CountActiveCubes() const;
+
+    void DumpPlane(int plane);
+    void Dump();
+
+  private:
+    void InitialiseZeroCube();
+
+    std::vector<std::vector<std::vector<std::vector<bool>>>> cube_;
+    Bounds x_bounds_;
+    Bounds y_bounds_;
+    Bounds z_bounds_;
+    Bounds w_bounds_;
+};
+
+
+// Parses the initial slice of active (#) and inactive (.) cubes.
+ConwayCube ParseInitialCube(std::string_view input);
+ConwayCube ParseInitialCubeFile(const std::string& filename);
+ConwayHypercube ParseInitialHypercube(std::string_view input);
+ConwayHypercube ParseInitialHypercubeFile(const std::string& filename);
+
+ConwayCube EvaluateOneCycle(const ConwayCube& current);
+ConwayHypercube EvaluateOneCycle(const ConwayHypercube& current, ThreadPool* pool = nullptr);
+
+int EvaluateSixCyclesAndCountActiveCubes(const ConwayCube& first_cube);
+int EvaluateSixCyclesAndCountActiveCubes(const ConwayHypercube& first_cube, ThreadPool* pool = nullptr);
+
+}  // namespace day17
+
+#endif  // AOC_2020_17_CONWAY_CUBES_H_
@@ -0,0 +1,55 @@
+#include <string>
+#include <string_view>
+
+#include "../common/input_view.h"
+#include "../common/microbench.h"
+#include "conway_cubes.h"
+
+namespace day17 {
+namespace {
+
+// The shipped starting slice tiled range(0) times side by side, so the slice
+// grows in proportion without changing its height.
+std::string MakeInput(const BenchmarkState& state) {
+    const std::string slice = ReadShippedInput("2020-17/data");
+    std::string result;
+    LineReader lines(slice);
+    std::string_view line;
+    while (lines.Next(line)) {
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            result.append(line);
+        }
+        result.push_back('\n');
+    }
+    return result;
+}
+
+void BM_ParseInitialCube(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(ParseInitialCube(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_ParseInitialCube)->Args({1, 10, 1000});
+
+void BM_EvaluateSixCycles3D(BenchmarkState& state) {
+    const ConwayCube first_cube = ParseInitialCube(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(EvaluateSixCyclesAndCountActiveCubes(first_cube));
+    }
+}
+MICROBENCHMARK(BM_EvaluateSixCycles3D)->Args({1, 10, 1000});
+
+// The 4D version is roughly 13 times the work, so stop short of 1000x.
+void BM_EvaluateSixCycles4D(BenchmarkState& state) {
+    const ConwayHypercube first_cube = ParseInitialHypercube(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(EvaluateSixCyclesAndCountActiveCubes(first_cube));
+    }
+}
+MICROBENCHMARK(BM_EvaluateSixCycles4D)->Args({1, 10, 100});
+
+}
+
+}  // namespace day17
@@ -0,0 +1,191 @@
+#include "operation_order.h"
+
+#include <exception>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day18 {
+
+namespace {
+
+enum Operator {
+    PLUS = 0,
+    MULT = 1,
+};
+
+std::string TokenTypeDebugString(TokenType type) {
+    switch (type) {
+        case TokenType::L_BRACE:
+            return "L_BRACE";
+        case TokenType::R_BRACE:
+            return "R_BRACE";
+        case TokenType::INT:
+            return "INT";
+        case TokenType::OPERATOR_PLUS:
+            return "OPERATOR_PLUS";
+        case TokenType::OPERATOR_MULT:
+            return "OPERATOR_MULT";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+void Assert(bool passed, std::string message = "") {
+    if (!passed) {
+        std::stringstream msg;
+        msg << "Assertion failed: " << message << ".";
+        throw std::runtime_error(msg.str());
+    }
+}
+
+std::runtime_error CreateInvalidCharacterException(char c) {
+    std::stringstream msg;
+    msg << "Invalid character in input: '" << c << "'!";
+    return std::runtime_error(msg.str());
+}
+
+std::queue<Token> LexProgramLine(std::string_view program) {
+    std::queue<Token> result;
+
+    for (const char c : program) {
+        if (c == ' ') {
+            continue;
+        } else if ('0' <= c && c <= '9') {
+            result.push({TokenType::INT, c - '0'});
+        } else {
+            switch (c) {
+                case '(':
+                    result.push({TokenType::L_BRACE});
+                    break;
+                case ')':
+                    result.push({TokenType::R_BRACE});
+                    break;
+                case '+':
+                    result.push({TokenType::OPERATOR_PLUS});
+                    break;
+                case '*':
+                    result.push({TokenType::OPERATOR_MULT});
+                    break;
+                default:
+                    throw CreateInvalidCharacterException(c);
+            }
+        }
+    }
+
+    return result;
+}
+
+long long EvaluateOperator(Operator op, long long left, long long right) {
+    switch (op) {
+        case Operator::PLUS:
+            return left + right;
+        case Operator::MULT:
+            return left * right;
+        default:
+            throw std::runtime_error("Unknown operator!");
+    }
+}
+
+long long EvaluateBracketedExpression(std::queue<Token>& program, Precedence precedence);
+
+long long EvaluateExpression(std::queue<Token>& program, Precedence precedence) {
+    long long accumulator;
+    Token t = program.front();
+    if (t.type == TokenType::L_BRACE) {
+        accumulator = EvaluateBracketedExpression(program, precedence);
+    } else {
+        Assert(t.type == TokenType::INT);
+        accumulator = t.data;
+        program.pop();
+    }
+    while (!program.empty()) {
+        Token t = program.front();
+        Operator op;
+        switch (t.type) {
+            case TokenType::R_BRACE:
+                return accumulator;
+            case TokenType::OPERATOR_PLUS:
+                op = Operator::PLUS;
+                break;
+            case TokenType::OPERATOR_MULT:
+                op = Operator::MULT;
+                break;
+            default:
+                throw std::runtime_error("Unexpected token!");
+        }
+
+        program.pop();
+        long long argument;
+
+        t = program.front();
+        if (op == Operator::MULT && precedence == Precedence::ADDITION_FIRST) {
+            // Multiplication has low precedence so we parse the whole remaining expression before
+            // applying the operator.
+            argument = EvaluateExpression(program, precedence);
+        } else if (t.type == TokenType::L_BRACE) {
+            argument = EvaluateBracketedExpression(program, precedence);
+        } else {
+            Assert(t.type == TokenType::INT);
+            argument = t.data;
+            program.pop();
+        }
+
+        accumulator = EvaluateOperator(op, accumulator, argument);
+    }
+    return accumulator;
+}
+
+long long EvaluateBracketedExpression(std::queue<Token>& program, Precedence precedence) {
+    Assert(program.front().type == TokenType::L_BRACE);
+    program.pop();
+    long long result = EvaluateExpression(program, precedence);
+    Assert(program.front().type == TokenType::R_BRACE);
+    program.pop();
+    return result;
+}
+
+}
+
+std::string Token::DebugString() const {
+    std::stringstream stream;
+    stream << "TOKEN(" << TokenTypeDebugString(type);
+    if (data != -123) {
+        stream << ", " << data;
+    }
+    stream << ")";
+    return stream.str();
+}
+
+std::vector<std::queue<Token>> Lex(std::string_view input) {
+    std::vector<std::queue<Token>> programs;
+    LineReader lines(input);
+    std::string_view program_text;
+
+    while (lines.Next(program_text)) {
+        programs.push_back(LexProgramLine(program_text));
+    }
+
+    return programs;
+}
+
+std::vector<std::queue<Token>> LexFile(const std::string& file_name) {
+    InputView input(file_name);
+    return Lex(input.contents());
+}
+
+std::vector<long long> EvaluateMultiplePrograms(std::vector<std::queue<Token>> programs, Precedence precedence) {
+    std::vector<long long> result;
+
+    for (auto& program : programs) {
+        result.push_back(EvaluateExpression(program, precedence));
+    }
+
+    return result;
+}
+
+}  // namespace day18
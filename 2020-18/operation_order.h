@@ -0,0 +1,43 @@
+#ifndef AOC_2020_18_OPERATION_ORDER_H_
+#define AOC_2020_18_OPERATION_ORDER_H_
+
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace day18 {
+
+enum TokenType {
+    L_BRACE = 0,
+    R_BRACE = 1,
+    INT = 2,
+    OPERATOR_PLUS = 3,
+    OPERATOR_MULT = 4,
+};
+
+struct Token {
+    TokenType type;
+    long long data = -123;
+
+    std::string DebugString() const;
+};
+
+enum Precedence {
+    // Operators apply left to right.
+    EQUAL = 0,
+    // Additions apply before multiplications.
+    ADDITION_FIRST = 1,
+};
+
+
+// Lexes one expression per line.
+std::vector<std::queue<Token>> Lex(std::string_view input);
+std::vector<std::queue<Token>> LexFile(const std::string& file_name);
+
+std::vector<long long> EvaluateMultiplePrograms(std::vector<std::queue<Token>> programs, Precedence precedence);
+
+}  // namespace day18
+
+#endif  // AOC_2020_18_OPERATION_ORDER_H_
@@ -0,0 +1,166 @@
+#include "monster_messages.h"
+
+#include <exception>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "../common/input_view.h"
+
+namespace day19 {
+
+// Match n: [some rule].
+const std::string kRuleRegex = R"regex((\d+): (.+))regex";
+// Match "x" with x being some a-z letter.
+const std::string kCharacterRegex = R"regex("([a-z])")regex";
+// Match a branching rule like 1 2 | 3 4
+const std::string kBranchRuleRegex = R"regex((.+?) \| (.+))regex";
+
+
+std::string DebugString(Rule rule) {
+    if (std::holds_alternative<CharRule>(rule)) {
+        auto char_rule = std::get<CharRule>(rule);
+        std::stringstream result;
+        result << "\"" << char_rule.c << "\"";
+        return result.str();
+    } else if (std::holds_alternative<ListRule>(rule)) {
+        auto list_rule = std::get<ListRule>(rule);
+        std::stringstream result;
+        result << "[";
+        for (const auto& rule : list_rule.sub_rules) {
+            result << rule << ", ";
+        }
+        result << "]";
+        return result.str();
+    } else {
+        auto branch_rule = std::get<BranchRule>(rule);
+        std::stringstream result;
+        result << "{";
+        result << DebugString(branch_rule.left);
+        result << " OR ";
+        result << DebugString(branch_rule.right);
+        result << "}";
+        return result.str();
+    }
+}
+
+namespace {
+
+ListRule ParseListRule(std::string input) {
+    std::vector<int> sub_rules;
+
+    Scanner scanner(input);
+    int rule;
+    while (scanner.NextInt(rule)) {
+        sub_rules.push_back(rule);
+    }
+
+    return {sub_rules};
+}
+
+Rule ParseRule(std::string rule) {
+    std::regex char_regex(kCharacterRegex);
+    std::regex branch_regex(kBranchRuleRegex);
+    std::smatch match;
+
+    if (std::regex_match(rule, match, char_regex)) {
+        std::string value = match[1];
+        return CharRule{value[0]};
+    } else if (std::regex_match(rule, match, branch_regex)) {
+        auto left = ParseListRule(match[1]);
+        auto right = ParseListRule(match[2]);
+        return BranchRule{left, right};
+    } else {
+        return ParseListRule(rule);
+    }
+}
+
+std::pair<int, Rule> ParseRuleLine(std::string_view rule_line) {
+    std::regex rule_regex(kRuleRegex);
+    std::match_results<std::string_view::const_iterator> match;
+
+    if (std::regex_match(rule_line.begin(), rule_line.end(), match, rule_regex)) {
+        int id = std::stoi(match[1]);
+        return {id, ParseRule(match[2])};
+    } else {
+        std::stringstream msg;
+        msg << "Invalid rule line in input: " << rule_line;
+        throw std::runtime_error(msg.str());
+    }
+}
+
+}
+
+ProblemData ParseProblemData(std::string_view input) {
+    LineReader lines(input);
+    std::string_view line;
+
+    std::unordered_map<int, Rule> rules;
+    while (lines.Next(line) && !line.empty()) {
+        rules.insert(ParseRuleLine(line));
+    }
+
+    std::vector<std::string> examples;
+    while (lines.Next(line)) {
+        examples.emplace_back(line);
+    }
+
+    return {rules, examples};
+}
+
+ProblemData ParseProblemDataFile(const std::string& file_name) {
+    InputView input(file_name);
+    return ParseProblemData(input.contents());
+}
+
+
+bool Parser::Matches() {
+    return MatchRule(rules_.at(0)) && parse_index_ == input_.size();
+}
+
+bool Parser::MatchRule(Rule rule) {
+    if (std::holds_alternative<CharRule>(rule)) {
+        auto char_rule = std::get<CharRule>(rule);
+        return input_[parse_index_++] == char_rule.c;
+    } else if (std::holds_alternative<ListRule>(rule)) {
+        auto list_rule = std::get<ListRule>(rule);
+        for (const auto& sub_rule : list_rule.sub_rules) {
+            if (!MatchRule(rules_.at(sub_rule))) {
+                return false;
+            }
+        }
+        return true;
+    } else {  // Branch rule.
+        auto branch_rule = std::get<BranchRule>(rule);
+        int current_parse_index = parse_index_;
+        if (MatchRule(branch_rule.left)) {
+            return true;
+        }
+        parse_index_ = current_parse_index;
+        return MatchRule(branch_rule.right);
+    }
+    return true;
+}
+
+bool ExampleMatchesRules(const std::string& example, const std::unordered_map<int, Rule>& rules) {
+    return Parser(example, rules).Matches();
+}
+
+int CountMatches(const std::vector<std::string>& examples, const std::unordered_map<int, Rule>& rules) {
+    int matches = 0;
+
+    for (const auto& example : examples) {
+        if (ExampleMatchesRules(example, rules)) {
+            matches++;
+        }
+    }
+
+    return matches;
+}
+
+}  // namespace day19
@@ -0,0 +1,65 @@
+#ifndef AOC_2020_19_MONSTER_MESSAGES_H_
+#define AOC_2020_19_MONSTER_MESSAGES_H_
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+
+namespace day19 {
+
+struct CharRule {
+    char c;
+    CharRule(char ch): c(ch) {}
+};
+
+struct ListRule {
+    std::vector<int> sub_rules;
+    ListRule(std::vector<int> rules): sub_rules(rules) {}
+};
+
+struct BranchRule {
+    ListRule left;
+    ListRule right;
+    BranchRule(ListRule l, ListRule r) : left(l), right(r) {}
+};
+
+typedef std::variant<CharRule, ListRule, BranchRule> Rule;
+
+struct ProblemData {
+    std::unordered_map<int, Rule> rules;
+    std::vector<std::string> examples;
+};
+
+std::string DebugString(Rule rule);
+
+// Parses the rules, then a blank line, then the messages to check.
+ProblemData ParseProblemData(std::string_view input);
+ProblemData ParseProblemDataFile(const std::string& file_name);
+
+// Checks a single message against rule 0, backtracking at most once per
+// branch.
+class Parser {
+  public:
+    Parser(std::string input, const std::unordered_map<int, Rule>& rules)
+        : input_(input), parse_index_(0), rules_(rules) {}
+
+    bool Matches();
+
+  private:
+    bool MatchRule(Rule rule);
+
+    std::string input_;
+    int parse_index_;
+    const std::unordered_map<int, Rule>& rules_;
+};
+
+bool ExampleMatchesRules(const std::string& example, const std::unordered_map<int, Rule>& rules);
+
+int CountMatches(const std::vector<std::string>& examples, const std::unordered_map<int, Rule>& rules);
+
+}  // namespace day19
+
+#endif  // AOC_2020_19_MONSTER_MESSAGES_H_
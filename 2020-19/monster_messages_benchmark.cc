@@ -0,0 +1,45 @@
+#include <string>
+#include <string_view>
+
+#include "../common/microbench.h"
+#include "monster_messages.h"
+
+namespace day19 {
+namespace {
+
+// The shipped rules followed by the shipped messages repeated range(0) times.
+std::string MakeInput(const BenchmarkState& state) {
+    const std::string data = ReadShippedInput("2020-19/data");
+    std::string_view text = data;
+    size_t split = text.find("\n\n");
+    if (split == std::string_view::npos) {
+        split = text.find("\r\n\r\n");
+    }
+    const size_t messages_start = text.find_first_not_of("\r\n", split);
+
+    std::string result(text.substr(0, messages_start));
+    result.append(RepeatLines(text.substr(messages_start), state.range(0)));
+    return result;
+}
+
+void BM_ParseProblemData(BenchmarkState& state) {
+    const std::string input = MakeInput(state);
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(ParseProblemData(input));
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+MICROBENCHMARK(BM_ParseProblemData)->Args({1, 10, 1000});
+
+void BM_CountMatches(BenchmarkState& state) {
+    const ProblemData problem_data = ParseProblemData(MakeInput(state));
+    for ([[maybe_unused]] auto _ : state) {
+        DoNotOptimize(CountMatches(problem_data.examples, problem_data.rules));
+    }
+    state.SetItemsProcessed(state.iterations() * problem_data.examples.size());
+}
+MICROBENCHMARK(BM_CountMatches)->Args({1, 10, 1000});
+
+}
+
+}  // namespace day19
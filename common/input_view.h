@@ -0,0 +1,242 @@
+#ifndef COMMON_INPUT_VIEW_H_
+#define COMMON_INPUT_VIEW_H_
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+// Build with -DINPUT_VIEW_MMAP=0 to read files into memory instead of mapping
+// them, which is also what happens on non-POSIX platforms.
+#ifndef INPUT_VIEW_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define INPUT_VIEW_MMAP 1
+#else
+#define INPUT_VIEW_MMAP 0
+#endif
+#endif
+
+#if INPUT_VIEW_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+
+// A whole input file as one read-only block of characters. On POSIX systems
+// the file is memory-mapped, so nothing is copied until a parser decides to
+// keep something; elsewhere it's read into memory in one go.
+class InputView {
+  public:
+    explicit InputView(const std::string& file_path) {
+#if INPUT_VIEW_MMAP
+        int fd = open(file_path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw CreateOpenFailedException(file_path);
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw CreateOpenFailedException(file_path);
+        }
+
+        size_ = info.st_size;
+        if (size_ > 0) {
+            void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                throw CreateOpenFailedException(file_path);
+            }
+            madvise(mapping, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(mapping);
+        }
+        close(fd);
+#else
+        std::ifstream infile(file_path, std::ios::binary);
+        if (!infile) {
+            throw CreateOpenFailedException(file_path);
+        }
+        buffer_.assign(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+    }
+
+    InputView(const InputView&) = delete;
+    InputView& operator=(const InputView&) = delete;
+
+    ~InputView() {
+#if INPUT_VIEW_MMAP
+        if (data_ != nullptr) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+    }
+
+    std::string_view contents() const { return {data_, size_}; }
+
+  private:
+    static std::runtime_error CreateOpenFailedException(const std::string& file_path) {
+        std::stringstream msg;
+        msg << "Couldn't open input file '" << file_path << "'!";
+        return std::runtime_error(msg.str());
+    }
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#if !INPUT_VIEW_MMAP
+    std::string buffer_;
+#endif
+};
+
+
+// Splits text on a delimiter like repeated calls to std::getline: a trailing
+// delimiter doesn't produce an empty final field. The fields point into the
+// original text.
+class FieldReader {
+  public:
+    FieldReader(std::string_view text, char delimiter) : text_(text), delimiter_(delimiter) {}
+
+    bool Next(std::string_view& field) {
+        if (text_.empty()) {
+            return false;
+        }
+
+        size_t end = text_.find(delimiter_);
+        if (end == std::string_view::npos) {
+            field = text_;
+            text_ = {};
+        } else {
+            field = text_.substr(0, end);
+            text_.remove_prefix(end + 1);
+        }
+        return true;
+    }
+
+  private:
+    std::string_view text_;
+    char delimiter_;
+};
+
+// Splits text into lines like repeated calls to std::getline, also dropping
+// the '\r' from Windows line endings.
+class LineReader {
+  public:
+    explicit LineReader(std::string_view text) : fields_(text, '\n') {}
+
+    bool Next(std::string_view& line) {
+        if (!fields_.Next(line)) {
+            return false;
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        return true;
+    }
+
+  private:
+    FieldReader fields_;
+};
+
+
+// Parses an integer from the start of 'text', allowing a leading '+' as well
+// as '-'. Returns the number of characters used, or zero if there isn't an
+// integer there (or it doesn't fit in T).
+template <typename T>
+size_t ParseIntPrefix(std::string_view text, T& value) {
+    size_t start = 0;
+    if (text.size() > 1 && text[0] == '+' && text[1] != '-') {
+        start = 1;
+    }
+
+    const char* first = text.data() + start;
+    const auto [end, error] = std::from_chars(first, text.data() + text.size(), value);
+    if (error != std::errc()) {
+        return 0;
+    }
+    return end - text.data();
+}
+
+// Parses 'text', which must be an integer and nothing else.
+template <typename T = int>
+T ParseInt(std::string_view text) {
+    T value;
+    if (text.empty() || ParseIntPrefix(text, value) != text.size()) {
+        std::stringstream msg;
+        msg << "Expected an integer but found '" << text << "'!";
+        throw std::runtime_error(msg.str());
+    }
+    return value;
+}
+
+
+// Reads whitespace-separated values in sequence, standing in for chains of
+// operator>> on a stream. As with a stream, a read that fails (including at
+// the end of the text) returns false.
+class Scanner {
+  public:
+    explicit Scanner(std::string_view text) : text_(text) {}
+
+    bool AtEnd() {
+        SkipWhitespace();
+        return text_.empty();
+    }
+
+    bool NextToken(std::string_view& token) {
+        SkipWhitespace();
+        if (text_.empty()) {
+            return false;
+        }
+
+        size_t end = 0;
+        while (end < text_.size() && !IsSpace(text_[end])) {
+            ++end;
+        }
+        token = text_.substr(0, end);
+        text_.remove_prefix(end);
+        return true;
+    }
+
+    bool NextChar(char& c) {
+        SkipWhitespace();
+        if (text_.empty()) {
+            return false;
+        }
+
+        c = text_[0];
+        text_.remove_prefix(1);
+        return true;
+    }
+
+    template <typename T>
+    bool NextInt(T& value) {
+        SkipWhitespace();
+        size_t used = ParseIntPrefix(text_, value);
+        text_.remove_prefix(used);
+        return used > 0;
+    }
+
+  private:
+    static bool IsSpace(char c) {
+        return std::isspace(static_cast<unsigned char>(c));
+    }
+
+    void SkipWhitespace() {
+        while (!text_.empty() && IsSpace(text_[0])) {
+            text_.remove_prefix(1);
+        }
+    }
+
+    std::string_view text_;
+};
+
+#endif  // COMMON_INPUT_VIEW_H_
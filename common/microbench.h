@@ -0,0 +1,251 @@
+#ifndef COMMON_MICROBENCH_H_
+#define COMMON_MICROBENCH_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "input_view.h"
+
+
+// A small stand-in for Google Benchmark, with the same shape:
+//
+//   void BM_Something(BenchmarkState& state) {
+//       auto input = MakeInput(state.range(0));  // Not timed.
+//       for ([[maybe_unused]] auto _ : state) {
+//           DoNotOptimize(Something(input));
+//       }
+//   }
+//   MICROBENCHMARK(BM_Something)->Args({1, 10, 1000});
+//
+// Each benchmark is rerun with more iterations until it takes at least the
+// minimum time, and the time per iteration is reported.
+
+
+// Stops the compiler from optimising away the computation of 'value'.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+
+class BenchmarkState {
+  public:
+    typedef std::chrono::steady_clock Clock;
+
+    BenchmarkState(int64_t arg, int64_t iterations) : arg_(arg), iterations_(iterations) {}
+
+    int64_t range(int = 0) const { return arg_; }
+    int64_t iterations() const { return iterations_; }
+
+    // Excludes per-iteration setup from the timing.
+    void PauseTiming() { elapsed_ += Clock::now() - started_; }
+    void ResumeTiming() { started_ = Clock::now(); }
+
+    void SetItemsProcessed(int64_t items) { items_processed_ = items; }
+    int64_t items_processed() const { return items_processed_; }
+
+    Clock::duration elapsed() const { return elapsed_; }
+
+    class Iterator {
+      public:
+        Iterator(BenchmarkState* state, int64_t remaining) : state_(state), remaining_(remaining) {}
+
+        bool operator!=(const Iterator& other) const {
+            if (remaining_ != other.remaining_) return true;
+            state_->PauseTiming();
+            return false;
+        }
+        void operator++() { --remaining_; }
+        int operator*() const { return 0; }
+
+      private:
+        BenchmarkState* state_;
+        int64_t remaining_;
+    };
+
+    Iterator begin() {
+        ResumeTiming();
+        return {this, iterations_};
+    }
+    Iterator end() { return {this, 0}; }
+
+  private:
+    int64_t arg_;
+    int64_t iterations_;
+    int64_t items_processed_ = 0;
+    Clock::time_point started_;
+    Clock::duration elapsed_ = Clock::duration::zero();
+};
+
+typedef void (*BenchmarkFunction)(BenchmarkState&);
+
+class Benchmark {
+  public:
+    Benchmark(std::string name, BenchmarkFunction function) : name_(std::move(name)), function_(function) {}
+
+    Benchmark* Arg(int64_t arg) {
+        args_.push_back(arg);
+        return this;
+    }
+
+    Benchmark* Args(std::initializer_list<int64_t> args) {
+        args_.insert(args_.end(), args.begin(), args.end());
+        return this;
+    }
+
+    const std::string& name() const { return name_; }
+    BenchmarkFunction function() const { return function_; }
+    bool has_args() const { return !args_.empty(); }
+    std::vector<int64_t> args() const { return args_.empty() ? std::vector<int64_t>{0} : args_; }
+
+  private:
+    std::string name_;
+    BenchmarkFunction function_;
+    std::vector<int64_t> args_;
+};
+
+inline std::vector<std::unique_ptr<Benchmark>>& BenchmarkRegistry() {
+    static std::vector<std::unique_ptr<Benchmark>> registry;
+    return registry;
+}
+
+inline Benchmark* RegisterBenchmark(const char* name, BenchmarkFunction function) {
+    BenchmarkRegistry().push_back(std::make_unique<Benchmark>(name, function));
+    return BenchmarkRegistry().back().get();
+}
+
+#define MICROBENCHMARK_CONCAT_(a, b) a##b
+#define MICROBENCHMARK_NAME_(line) MICROBENCHMARK_CONCAT_(microbenchmark_, line)
+#define MICROBENCHMARK(function) \
+    static Benchmark* MICROBENCHMARK_NAME_(__LINE__) [[maybe_unused]] = RegisterBenchmark(#function, function)
+
+
+// Reads one of the checked-in puzzle inputs, e.g. "2020-01/data".
+inline std::string ReadShippedInput(const std::string& relative_path) {
+    InputView input(std::string(AOC_SOURCE_DIR) + "/" + relative_path);
+    return std::string(input.contents());
+}
+
+// Concatenates 'times' copies of a line-based input.
+inline std::string RepeatLines(std::string_view text, int64_t times) {
+    std::string result;
+    result.reserve((text.size() + 1) * times);
+    for (int64_t i = 0; i < times; ++i) {
+        result.append(text);
+        if (!text.empty() && text.back() != '\n') {
+            result.push_back('\n');
+        }
+    }
+    return result;
+}
+
+
+namespace microbench_internal {
+
+inline std::string FormatDuration(double nanos) {
+    std::stringstream result;
+    result << std::fixed << std::setprecision(2);
+    if (nanos < 1e3) {
+        result << nanos << " ns";
+    } else if (nanos < 1e6) {
+        result << nanos / 1e3 << " us";
+    } else if (nanos < 1e9) {
+        result << nanos / 1e6 << " ms";
+    } else {
+        result << nanos / 1e9 << " s";
+    }
+    return result.str();
+}
+
+inline std::string FormatRate(double per_second) {
+    std::stringstream result;
+    result << std::fixed << std::setprecision(2);
+    if (per_second < 1e3) {
+        result << per_second << "/s";
+    } else if (per_second < 1e6) {
+        result << per_second / 1e3 << "k/s";
+    } else if (per_second < 1e9) {
+        result << per_second / 1e6 << "M/s";
+    } else {
+        result << per_second / 1e9 << "G/s";
+    }
+    return result.str();
+}
+
+}
+
+
+// Runs every registered benchmark whose name contains --filter=<text>, each
+// for at least --min_time=<seconds>.
+inline int RunMicrobenchmarks(int argc, char* argv[]) {
+    std::string filter;
+    double min_time = 0.5;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0) {
+            filter = arg.substr(9);
+        } else if (arg.rfind("--min_time=", 0) == 0) {
+            min_time = std::stod(std::string(arg.substr(11)));
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--filter=<substring>] [--min_time=<seconds>]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << std::left << std::setw(40) << "Benchmark" << std::right << std::setw(14) << "Time"
+              << std::setw(12) << "Iterations" << std::setw(14) << "Items/s" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    for (const auto& benchmark : BenchmarkRegistry()) {
+        for (const int64_t arg : benchmark->args()) {
+            std::stringstream name;
+            name << benchmark->name();
+            if (benchmark->has_args()) {
+                name << "/" << arg;
+            }
+            if (name.str().find(filter) == std::string::npos) continue;
+
+            // Grow the iteration count until the run is long enough to trust.
+            int64_t iterations = 1;
+            double seconds = 0;
+            int64_t items = 0;
+            for (;;) {
+                BenchmarkState state(arg, iterations);
+                benchmark->function()(state);
+                seconds = std::chrono::duration<double>(state.elapsed()).count();
+                items = state.items_processed();
+                if (seconds >= min_time || iterations >= 1000000000) break;
+
+                const double scale = seconds > 0 ? 1.4 * min_time / seconds : 100;
+                iterations = std::max(iterations + 1, static_cast<int64_t>(iterations * std::min(scale, 100.0)));
+            }
+
+            std::cout << std::left << std::setw(40) << name.str() << std::right << std::setw(14)
+                      << microbench_internal::FormatDuration(seconds * 1e9 / iterations)
+                      << std::setw(12) << iterations;
+            if (items > 0) {
+                std::cout << std::setw(14) << microbench_internal::FormatRate(items / seconds);
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    return 0;
+}
+
+#endif  // COMMON_MICROBENCH_H_
@@ -0,0 +1,228 @@
+#ifndef COMMON_THREAD_POOL_H_
+#define COMMON_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+// A fixed set of worker threads, each with its own queue of tasks.
+//
+// Workers take the newest task from their own queue and, once that's empty,
+// steal the oldest task from another worker's. Tasks submitted from inside a
+// task land on the submitting worker's queue, so a task that fans out into
+// subtasks keeps them close unless another worker is idle.
+class ThreadPool {
+  public:
+    typedef std::function<void()> Task;
+
+    explicit ThreadPool(unsigned num_threads = std::thread::hardware_concurrency())
+        : stopping_(false), pending_(0), next_queue_(0) {
+        num_threads = std::max(1u, num_threads);
+        for (unsigned i = 0; i < num_threads; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads_.emplace_back([this, i]() { WorkerLoop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Finishes every queued task before joining the workers.
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    size_t size() const { return threads_.size(); }
+
+    void Submit(Task task) {
+        size_t queue = CurrentWorker().value_or(
+            next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size());
+        {
+            std::lock_guard<std::mutex> lock(queues_[queue]->mutex);
+            queues_[queue]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            ++pending_;
+        }
+        wake_.notify_one();
+    }
+
+  private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct WorkerIdentity {
+        const ThreadPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    static WorkerIdentity& ThisThread() {
+        static thread_local WorkerIdentity identity;
+        return identity;
+    }
+
+    std::optional<size_t> CurrentWorker() const {
+        const WorkerIdentity& identity = ThisThread();
+        if (identity.pool != this) return std::nullopt;
+        return identity.index;
+    }
+
+    std::optional<Task> PopOwn(size_t index) {
+        Queue& queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return std::nullopt;
+        Task task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return task;
+    }
+
+    std::optional<Task> Steal(size_t thief) {
+        for (size_t offset = 1; offset < queues_.size(); ++offset) {
+            Queue& queue = *queues_[(thief + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            Task task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return task;
+        }
+        return std::nullopt;
+    }
+
+    bool TryRunOne(size_t index) {
+        std::optional<Task> task = PopOwn(index);
+        if (!task) task = Steal(index);
+        if (!task) return false;
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            --pending_;
+        }
+        (*task)();
+        return true;
+    }
+
+    void WorkerLoop(size_t index) {
+        ThisThread() = {this, index};
+        while (true) {
+            if (TryRunOne(index)) continue;
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_.wait(lock, [this]() { return stopping_ || pending_ > 0; });
+            if (stopping_ && pending_ == 0) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+
+    // Guarded by wake_mutex_.
+    bool stopping_;
+    size_t pending_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+
+    std::atomic<size_t> next_queue_;
+};
+
+
+// Blocks callers of Wait() until CountDown() has been called 'count' times.
+class CountdownLatch {
+  public:
+    explicit CountdownLatch(size_t count) : remaining_(count) {}
+
+    void CountDown() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--remaining_ == 0) {
+            done_.notify_all();
+        }
+    }
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return remaining_ == 0; });
+    }
+
+  private:
+    size_t remaining_;
+    std::mutex mutex_;
+    std::condition_variable done_;
+};
+
+
+// Calls body(i) for every i in [begin, end) on the pool and waits for them
+// all. Without a pool the calls are made in order on the calling thread. The
+// first exception thrown by a call is rethrown once every call has finished.
+//
+// The calling thread and up to one task per worker take indices from a shared
+// counter until there are none left, so the caller only ever runs this loop's
+// calls, never unrelated tasks that happen to be queued, and never waits for
+// an index nobody has started. Once it runs out it blocks until the calls
+// other threads took have finished.
+inline void ParallelFor(ThreadPool* pool, int begin, int end, const std::function<void(int)>& body) {
+    if (pool == nullptr || end - begin <= 1) {
+        for (int i = begin; i < end; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    // Shared with the helper tasks, which may not start until after the loop
+    // has finished; by then there are no indices left, so they never touch
+    // 'body'.
+    struct Loop {
+        Loop(int begin, int end, const std::function<void(int)>* body)
+            : next(begin), end(end), body(body), finished(end - begin) {}
+
+        void Run() {
+            for (int i = next.fetch_add(1, std::memory_order_relaxed); i < end;
+                 i = next.fetch_add(1, std::memory_order_relaxed)) {
+                try {
+                    (*body)(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                }
+                finished.CountDown();
+            }
+        }
+
+        std::atomic<int> next;
+        const int end;
+        const std::function<void(int)>* body;
+        CountdownLatch finished;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    auto loop = std::make_shared<Loop>(begin, end, &body);
+    const size_t helpers = std::min<size_t>(pool->size(), end - begin - 1);
+    for (size_t helper = 0; helper < helpers; ++helper) {
+        pool->Submit([loop]() { loop->Run(); });
+    }
+    loop->Run();
+    loop->finished.Wait();
+    if (loop->error) std::rethrow_exception(loop->error);
+}
+
+#endif  // COMMON_THREAD_POOL_H_
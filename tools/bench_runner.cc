@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+
+// Runs each solver listed in a manifest against its input and reports wall
+// time, peak RSS and instructions retired. Each manifest line is a solver name
+// followed by the command to run, all separated by tabs.
+
+
+struct BenchEntry {
+    std::string name;
+    std::vector<std::string> command;
+};
+
+struct BenchResult {
+    bool timed_out = false;
+    int exit_status = 0;
+    double wall_ms = 0;
+    long peak_rss_kb = 0;
+    std::optional<uint64_t> instructions;
+};
+
+
+std::vector<BenchEntry> ParseManifest(const std::string& file_path) {
+    std::ifstream infile(file_path);
+    if (!infile) {
+        std::stringstream msg;
+        msg << "Couldn't open manifest '" << file_path << "'!";
+        throw std::runtime_error(msg.str());
+    }
+
+    std::vector<BenchEntry> entries;
+    std::string line;
+    while (std::getline(infile, line)) {
+        if (line.empty()) continue;
+
+        std::stringstream line_stream(line);
+        std::string field;
+        BenchEntry entry;
+        std::getline(line_stream, entry.name, '\t');
+        while (std::getline(line_stream, field, '\t')) {
+            entry.command.push_back(field);
+        }
+        if (entry.command.empty()) {
+            std::stringstream msg;
+            msg << "Manifest entry '" << entry.name << "' has no command!";
+            throw std::runtime_error(msg.str());
+        }
+        entries.push_back(entry);
+    }
+
+    return entries;
+}
+
+// Opens a counter of user-space instructions retired by 'pid' and any threads
+// it starts, which begins counting when the process calls exec.
+int OpenInstructionCounter(pid_t pid) {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.enable_on_exec = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attr, pid, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+BenchResult RunOnce(const BenchEntry& entry, int timeout_seconds) {
+    // The child waits on this pipe before exec so that the counter can be
+    // attached to it first.
+    int go_pipe[2];
+    if (pipe(go_pipe) != 0) {
+        throw std::runtime_error("Couldn't create pipe!");
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error("Couldn't fork!");
+    }
+
+    if (pid == 0) {
+        close(go_pipe[1]);
+        sigset_t child_signal;
+        sigemptyset(&child_signal);
+        sigaddset(&child_signal, SIGCHLD);
+        sigprocmask(SIG_UNBLOCK, &child_signal, nullptr);
+
+        char go;
+        if (read(go_pipe[0], &go, 1) != 1) _exit(127);
+        close(go_pipe[0]);
+
+        int null_fd = open("/dev/null", O_WRONLY);
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+
+        std::vector<char*> argv;
+        for (const std::string& arg : entry.command) {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+
+    close(go_pipe[0]);
+    int counter_fd = OpenInstructionCounter(pid);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::seconds(timeout_seconds);
+    if (write(go_pipe[1], "g", 1) != 1) {
+        throw std::runtime_error("Couldn't start child process!");
+    }
+    close(go_pipe[1]);
+
+    // SIGCHLD is blocked in main, so we can wait for it with a timeout.
+    sigset_t child_signal;
+    sigemptyset(&child_signal);
+    sigaddset(&child_signal, SIGCHLD);
+
+    BenchResult result;
+    int status = 0;
+    rusage usage;
+    while (wait4(pid, &status, WNOHANG, &usage) == 0) {
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration::zero()) {
+            kill(pid, SIGKILL);
+            wait4(pid, &status, 0, &usage);
+            result.timed_out = true;
+            break;
+        }
+
+        const auto remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+        timespec wait_time {
+            static_cast<time_t>(remaining_ns / 1000000000), static_cast<long>(remaining_ns % 1000000000)};
+        sigtimedwait(&child_signal, nullptr, &wait_time);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    result.wall_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    result.peak_rss_kb = usage.ru_maxrss;
+    if (!result.timed_out) {
+        result.exit_status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    }
+
+    if (counter_fd >= 0) {
+        uint64_t count;
+        if (read(counter_fd, &count, sizeof(count)) == sizeof(count)) {
+            result.instructions = count;
+        }
+        close(counter_fd);
+    }
+
+    return result;
+}
+
+// Runs an entry 'repeats' times, keeping the fastest wall time and the
+// largest peak RSS seen.
+BenchResult Run(const BenchEntry& entry, int timeout_seconds, int repeats) {
+    BenchResult best = RunOnce(entry, timeout_seconds);
+
+    for (int i = 1; i < repeats && !best.timed_out && best.exit_status == 0; ++i) {
+        BenchResult current = RunOnce(entry, timeout_seconds);
+        best.wall_ms = std::min(best.wall_ms, current.wall_ms);
+        best.peak_rss_kb = std::max(best.peak_rss_kb, current.peak_rss_kb);
+        if (best.instructions && current.instructions) {
+            best.instructions = std::min(*best.instructions, *current.instructions);
+        }
+        best.timed_out = current.timed_out;
+        best.exit_status = current.exit_status;
+    }
+
+    return best;
+}
+
+std::string DescribeStatus(const BenchResult& result) {
+    if (result.timed_out) {
+        return "timeout";
+    } else if (result.exit_status != 0) {
+        std::stringstream status;
+        status << "exit " << result.exit_status;
+        return status.str();
+    }
+    return "ok";
+}
+
+
+int main(int argc, char* argv[]) {
+    int timeout_seconds = 30;
+    int repeats = 1;
+    std::string manifest_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--timeout" && i + 1 < argc) {
+            timeout_seconds = std::stoi(argv[++i]);
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeats = std::max(1, std::stoi(argv[++i]));
+        } else {
+            manifest_path = arg;
+        }
+    }
+
+    if (manifest_path.empty()) {
+        std::cout << "Usage: " << argv[0] << " [--timeout <seconds>] [--repeat <n>] <manifest>";
+        return 1;
+    }
+
+    sigset_t child_signal;
+    sigemptyset(&child_signal);
+    sigaddset(&child_signal, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &child_signal, nullptr);
+
+    // Timeouts are reported but don't fail the run; a solver that crashes does.
+    bool all_passed = true;
+    std::cout << std::left << std::setw(12) << "solver" << std::setw(10) << "status"
+              << std::right << std::setw(12) << "wall ms" << std::setw(14) << "peak RSS KiB"
+              << std::setw(18) << "instructions" << std::endl;
+
+    for (const BenchEntry& entry : ParseManifest(manifest_path)) {
+        BenchResult result = Run(entry, timeout_seconds, repeats);
+        all_passed = all_passed && result.exit_status == 0;
+
+        std::cout << std::left << std::setw(12) << entry.name << std::setw(10) << DescribeStatus(result)
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(12) << result.wall_ms
+                  << std::setw(14) << result.peak_rss_kb << std::setw(18);
+        if (result.instructions) {
+            std::cout << *result.instructions;
+        } else {
+            std::cout << "n/a";
+        }
+        std::cout << std::endl;
+    }
+
+    return all_passed ? 0 : 1;
+}
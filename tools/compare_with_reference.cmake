@@ -0,0 +1,43 @@
+# Runs a solver and the Python script it was ported from on the same input, and
+# fails unless they print the same thing, give or take surrounding whitespace. With GENERATE set, the input is first
+# written by generate_input.
+#
+#   cmake -DPYTHON=<path> -DREFERENCE=<script.py> -DSOLVER=<path> -DINPUT=<file>
+#         [-DGENERATE_INPUT=<path> -DGENERATE=<day>;<size>] -P compare_with_reference.cmake
+
+if(GENERATE)
+  execute_process(
+    COMMAND "${GENERATE_INPUT}" ${GENERATE}
+    OUTPUT_FILE "${INPUT}"
+    ERROR_VARIABLE generator_answers
+    RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "generate_input ${GENERATE} failed")
+  endif()
+endif()
+
+execute_process(
+  COMMAND "${PYTHON}" "${REFERENCE}" "${INPUT}"
+  OUTPUT_VARIABLE expected
+  RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${REFERENCE} failed on ${INPUT}")
+endif()
+
+execute_process(
+  COMMAND "${SOLVER}" "${INPUT}"
+  OUTPUT_VARIABLE actual
+  RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${SOLVER} failed on ${INPUT}")
+endif()
+
+# Only the answers matter, not the trailing newlines.
+string(STRIP "${expected}" expected)
+string(STRIP "${actual}" actual)
+if(NOT actual STREQUAL expected)
+  message(FATAL_ERROR "${SOLVER} disagrees with ${REFERENCE} on ${INPUT}:\n"
+    "expected: ${expected}\n"
+    "actual:   ${actual}")
+endif()
+message(STATUS "${SOLVER} matches ${REFERENCE} on ${INPUT}: ${actual}")
@@ -0,0 +1,851 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+// Writes a valid puzzle input of any size to stdout, for measuring solvers on
+// more data than the shipped inputs hold:
+//
+//   generate_input 2020-07 100000 [--seed=<n>] > bags
+//
+// The size counts the records that make up the day's input (lines, rules,
+// instructions, tickets...). Where the answers are known from the way the
+// input was built, or cheap to work out on the side, they're written to stderr.
+
+
+typedef std::mt19937_64 Random;
+
+struct Answers {
+    std::optional<long long> part_a;
+    std::optional<long long> part_b;
+    // Anything the solvers need passing to read this input.
+    std::string solver_flags = "";
+};
+
+typedef Answers (*Generator)(long long size, Random& random, std::ostream& out);
+
+
+namespace {
+
+long long Uniform(Random& random, long long low, long long high) {
+    return std::uniform_int_distribution<long long>(low, high)(random);
+}
+
+bool Chance(Random& random, double probability) {
+    return std::bernoulli_distribution(probability)(random);
+}
+
+// A unique pronounceable word for every index, e.g. "bako", "dibeno".
+std::string WordForIndex(long long index) {
+    static const std::string kConsonants = "bdfgklmnprstvz";
+    static const std::string kVowels = "aeiou";
+    const long long syllables = kConsonants.size() * kVowels.size();
+
+    std::string word;
+    do {
+        word += kConsonants[index % syllables / kVowels.size()];
+        word += kVowels[index % kVowels.size()];
+        index /= syllables;
+    } while (index > 0);
+    return word;
+}
+
+}
+
+
+// Password policies: "1-3 a: abcde".
+Answers GeneratePasswordPolicies(long long size, Random& random, std::ostream& out) {
+    long long valid_by_count = 0;
+    long long valid_by_position = 0;
+
+    for (long long i = 0; i < size; ++i) {
+        const int length = Uniform(random, 4, 20);
+        const int low = Uniform(random, 1, length - 1);
+        const int high = Uniform(random, low + 1, length);
+        const char letter = 'a' + Uniform(random, 0, 25);
+
+        // Bias the password towards the policy's letter so both parts see a
+        // mix of valid and invalid entries.
+        std::string password;
+        for (int j = 0; j < length; ++j) {
+            password += Chance(random, 0.4) ? letter : static_cast<char>('a' + Uniform(random, 0, 25));
+        }
+
+        const int count = std::count(password.begin(), password.end(), letter);
+        valid_by_count += count >= low && count <= high;
+        valid_by_position += (password[low - 1] == letter) != (password[high - 1] == letter);
+        out << low << "-" << high << " " << letter << ": " << password << "\n";
+    }
+
+    return {valid_by_count, valid_by_position};
+}
+
+// A tree map one row per record, as wide as the shipped one.
+Answers GenerateTreeGrid(long long size, Random& random, std::ostream& out) {
+    const int kWidth = 31;
+    std::vector<std::string> rows;
+    for (long long y = 0; y < size; ++y) {
+        std::string row;
+        for (int x = 0; x < kWidth; ++x) {
+            row += Chance(random, 0.25) ? '#' : '.';
+        }
+        out << row << "\n";
+        rows.push_back(std::move(row));
+    }
+
+    auto count_hits = [&rows](int velx, int vely) {
+        long long hits = 0;
+        for (long long x = 0, y = 0; y < static_cast<long long>(rows.size()); x = (x + velx) % kWidth, y += vely) {
+            hits += rows[y][x] == '#';
+        }
+        return hits;
+    };
+
+    long long product = 1;
+    for (const auto& [velx, vely] : std::vector<std::pair<int, int>>{{1, 1}, {3, 1}, {5, 1}, {7, 1}, {1, 2}}) {
+        product *= count_hits(velx, vely);
+    }
+    return {count_hits(3, 1), product};
+}
+
+// Passports with each required field left out now and then, and each value
+// drawn from either valid or invalid examples, blank lines between them. The
+// valid values include ones that only pass by their prefix ("170cmx", "blux")
+// as the original rules allow.
+Answers GeneratePassports(long long size, Random& random, std::ostream& out) {
+    auto digits = [&random](int count) {
+        std::string result;
+        for (int i = 0; i < count; ++i) {
+            result += static_cast<char>('0' + Uniform(random, 0, 9));
+        }
+        return result;
+    };
+    auto year = [&random](int low, int high, bool valid) {
+        if (valid) return std::to_string(Uniform(random, low, high));
+        return Chance(random, 0.5) ? std::to_string(Uniform(random, 1000, low - 1))
+                                   : std::to_string(Uniform(random, high + 1, 9999));
+    };
+    auto value_for = [&](int field, bool valid) -> std::string {
+        static const std::vector<std::string> kEyeColours = {"amb", "blu", "brn", "gry", "grn", "hzl", "oth"};
+        static const std::string kHex = "0123456789abcdef";
+        switch (field) {
+            case 0: return year(1920, 2002, valid);
+            case 1: return year(2010, 2020, valid);
+            case 2: return year(2020, 2030, valid);
+            case 3: {
+                const bool cm = Chance(random, 0.5);
+                const int height = valid ? (cm ? Uniform(random, 150, 193) : Uniform(random, 59, 76))
+                                         : (cm ? Uniform(random, 194, 250) : Uniform(random, 10, 58));
+                std::string unit = cm ? "cm" : "in";
+                if (!valid && Chance(random, 0.3)) unit = "";
+                return std::to_string(height) + unit + (valid && Chance(random, 0.05) ? "x" : "");
+            }
+            case 4: {
+                std::string colour = "#";
+                for (int i = 0; i < 6; ++i) colour += kHex[Uniform(random, 0, 15)];
+                if (valid) return Chance(random, 0.05) ? colour + "z" : colour;
+                return Chance(random, 0.5) ? colour.substr(1) : colour.substr(0, 6);
+            }
+            case 5: {
+                if (!valid) return Chance(random, 0.5) ? "xry" : "bl";
+                const std::string& colour = kEyeColours[Uniform(random, 0, kEyeColours.size() - 1)];
+                return Chance(random, 0.05) ? colour + "x" : colour;
+            }
+            case 6:
+                return valid ? digits(9) : digits(Chance(random, 0.5) ? 8 : 10);
+            default:
+                return digits(3);
+        }
+    };
+    static const std::vector<std::string> kKeys = {"byr", "iyr", "eyr", "hgt", "hcl", "ecl", "pid", "cid"};
+
+    long long complete = 0;
+    long long valid = 0;
+    for (long long i = 0; i < size; ++i) {
+        std::vector<int> fields;
+        bool all_valid = true;
+        for (int field = 0; field < 7; ++field) {
+            if (Chance(random, 0.95)) fields.push_back(field);
+        }
+        if (Chance(random, 0.5)) fields.push_back(7);
+        std::shuffle(fields.begin(), fields.end(), random);
+
+        if (i > 0) out << "\n";
+        for (size_t j = 0; j < fields.size(); ++j) {
+            const bool field_valid = fields[j] == 7 || Chance(random, 0.97);
+            all_valid = all_valid && field_valid;
+            out << kKeys[fields[j]] << ":" << value_for(fields[j], field_valid);
+            out << (j + 1 == fields.size() || Chance(random, 0.3) ? "\n" : " ");
+        }
+
+        const bool has_required = std::count_if(fields.begin(), fields.end(), [](int f) { return f < 7; }) == 7;
+        complete += has_required;
+        valid += has_required && all_valid;
+    }
+
+    return {complete, valid};
+}
+
+// Boarding passes for a contiguous run of seats with one gap, shuffled. The
+// puzzle's plane has 1024 seats; larger sizes get a plane with more rows,
+// which the solvers need telling about.
+Answers GenerateBoardingPasses(long long size, Random& random, std::ostream& out) {
+    const int kColumnBits = 3;
+    int row_bits = 7;
+    while (row_bits < 58 && (1LL << (row_bits + kColumnBits)) - 2 < size) {
+        ++row_bits;
+    }
+    const int bits = row_bits + kColumnBits;
+    const long long seats = 1LL << bits;
+    const long long count = std::clamp<long long>(size, 3, seats - 2);
+    const long long first = Uniform(random, 0, seats - count - 1);
+    const long long missing = Uniform(random, first + 1, first + count - 1);
+
+    std::vector<long long> seat_ids;
+    for (long long id = first; id <= first + count; ++id) {
+        if (id != missing) {
+            seat_ids.push_back(id);
+        }
+    }
+    std::shuffle(seat_ids.begin(), seat_ids.end(), random);
+
+    std::string pass(bits + 1, '\n');
+    for (const long long id : seat_ids) {
+        for (int bit = bits - 1; bit >= 0; --bit) {
+            const bool set = (id >> bit) & 1;
+            pass[bits - 1 - bit] = bit >= kColumnBits ? (set ? 'B' : 'F') : (set ? 'R' : 'L');
+        }
+        out << pass;
+    }
+
+    Answers answers = {first + count, missing};
+    if (row_bits != 7) {
+        answers.solver_flags = "--row-bits=" + std::to_string(row_bits);
+    }
+    return answers;
+}
+
+// Customs answers: groups of one to five people, each answering a few
+// questions, with the group's favourite questions more likely.
+Answers GenerateCustomsForms(long long size, Random& random, std::ostream& out) {
+    long long answered_by_anyone = 0;
+    long long answered_by_everyone = 0;
+
+    for (long long i = 0; i < size; ++i) {
+        const int people = Uniform(random, 1, 5);
+        const unsigned favourites = random() & ((1u << 26) - 1) & random();
+        unsigned anyone = 0;
+        unsigned everyone = (1u << 26) - 1;
+
+        if (i > 0) out << "\n";
+        for (int person = 0; person < people; ++person) {
+            std::string answers;
+            unsigned mask = 0;
+            for (int question = 0; question < 26; ++question) {
+                if (Chance(random, (favourites >> question) & 1 ? 0.9 : 0.1)) {
+                    answers += static_cast<char>('a' + question);
+                    mask |= 1u << question;
+                }
+            }
+            // People answer in any order, and at least one question.
+            std::shuffle(answers.begin(), answers.end(), random);
+            if (answers.empty()) {
+                answers = "z";
+                mask = 1u << 25;
+            }
+            out << answers << "\n";
+            anyone |= mask;
+            everyone &= mask;
+        }
+
+        answered_by_anyone += __builtin_popcount(anyone);
+        answered_by_everyone += __builtin_popcount(everyone);
+    }
+
+    return {answered_by_anyone, answered_by_everyone};
+}
+
+// Bag rules forming a DAG: each bag only holds bags defined after it. Shiny
+// gold goes late enough that most bags can reach it, and where the number of
+// bags it holds is largest while still fitting in an int.
+Answers GenerateBagRules(long long size, Random& random, std::ostream& out) {
+    static const std::vector<std::string> kColours = {
+        "red", "orange", "yellow", "green", "blue", "indigo", "violet", "black", "white", "grey",
+        "teal", "cyan", "magenta", "maroon", "olive", "lime", "tan", "beige", "plum", "salmon"};
+    const long long kMaxHeld = 1000000000;
+    const int count = std::max<long long>(size, 2);
+
+    std::vector<std::vector<std::pair<int, int>>> contents(count);
+    for (int bag = 0; bag < count; ++bag) {
+        if (bag + 1 == count || Chance(random, 0.15)) continue;
+        const int kinds = Uniform(random, 1, 4);
+        for (int k = 0; k < kinds; ++k) {
+            const int inner = Uniform(random, bag + 1, std::min(count - 1, bag + 50));
+            const bool duplicate = std::any_of(
+                contents[bag].begin(), contents[bag].end(),
+                [inner](const std::pair<int, int>& held) { return held.first == inner; });
+            if (!duplicate) {
+                contents[bag].push_back({inner, static_cast<int>(Uniform(random, 1, 5))});
+            }
+        }
+    }
+
+    // Bags held (saturating), working back from the end. The target is the
+    // bag in the back half that holds the most without going over.
+    std::vector<long long> held(count, 0);
+    int target = count - 1;
+    for (int bag = count - 1; bag >= 0; --bag) {
+        for (const auto& [inner, number] : contents[bag]) {
+            held[bag] = std::min(kMaxHeld + 1, held[bag] + number * (1 + held[inner]));
+        }
+        if (bag >= count / 2 && held[bag] <= kMaxHeld && held[bag] > held[target]) {
+            target = bag;
+        }
+    }
+
+    std::vector<bool> reaches_target(count, false);
+    reaches_target[target] = true;
+    long long containers = 0;
+    for (int bag = target - 1; bag >= 0; --bag) {
+        for (const auto& held_bag : contents[bag]) {
+            reaches_target[bag] = reaches_target[bag] || reaches_target[held_bag.first];
+        }
+        containers += reaches_target[bag];
+    }
+
+    std::vector<std::string> names(count);
+    for (int bag = 0; bag < count; ++bag) {
+        names[bag] = WordForIndex(bag) + " " + kColours[Uniform(random, 0, kColours.size() - 1)];
+    }
+    names[target] = "shiny gold";
+
+    std::vector<int> order(count);
+    for (int bag = 0; bag < count; ++bag) order[bag] = bag;
+    std::shuffle(order.begin(), order.end(), random);
+
+    for (const int bag : order) {
+        out << names[bag] << " bags contain ";
+        if (contents[bag].empty()) {
+            out << "no other bags";
+        }
+        for (size_t i = 0; i < contents[bag].size(); ++i) {
+            const auto& [inner, number] = contents[bag][i];
+            out << (i == 0 ? "" : ", ") << number << " " << names[inner] << (number == 1 ? " bag" : " bags");
+        }
+        out << ".\n";
+    }
+
+    return {containers, held[target]};
+}
+
+// A handheld program whose path runs forward through accs, "nop +0"s and
+// short forward jumps over "jmp +0"s, except for one backwards jump that
+// loops. Flipping any other nop or jmp on the path still loops, so fixing
+// that jump is the only repair.
+Answers GenerateHandheldProgram(long long size, Random& random, std::ostream& out) {
+    const long long count = std::max<long long>(size, 3);
+    // Each step covers at most five instructions, so the trap always fits.
+    const long long trap_step = Uniform(random, 1, std::max<long long>(1, count / 10));
+
+    std::vector<std::string> program;
+    std::vector<long long> path;
+    long long accumulator = 0;
+    long long accumulator_before_trap = 0;
+    auto format = [](const char* op, long long argument) {
+        return std::string(op) + (argument < 0 ? " -" : " +") + std::to_string(std::abs(argument));
+    };
+
+    while (static_cast<long long>(program.size()) < count) {
+        const long long here = program.size();
+        const long long remaining = count - here;
+        if (static_cast<long long>(path.size()) == trap_step) {
+            accumulator_before_trap = accumulator;
+            const long long back_to = path[Uniform(random, 0, path.size() - 1)];
+            program.push_back(format("jmp", back_to - here));
+        } else if (const int roll = Uniform(random, 0, 99); roll < 55) {
+            const long long argument = Uniform(random, -50, 50);
+            accumulator += argument;
+            program.push_back(format("acc", argument));
+        } else if (roll < 70 || remaining < 2) {
+            program.push_back(format("nop", 0));
+        } else {
+            // Don't jump off the end before the trap is in place.
+            const bool trap_placed = static_cast<long long>(path.size()) > trap_step;
+            const long long jump = Uniform(random, 1, std::min<long long>(5, trap_placed ? remaining : remaining - 1));
+            program.push_back(format("jmp", jump));
+            for (long long skipped = 1; skipped < jump; ++skipped) {
+                program.push_back(format("jmp", 0));
+            }
+        }
+        path.push_back(here);
+    }
+
+    for (const auto& instruction : program) {
+        out << instruction << "\n";
+    }
+
+    return {accumulator_before_trap, accumulator};
+}
+
+namespace {
+
+// The seats each seat watches: adjacent ones, or the first in each direction.
+std::vector<std::vector<int>> SeatNeighbours(const std::vector<std::string>& rows, bool line_of_sight) {
+    const int height = rows.size();
+    const int width = rows[0].size();
+    std::vector<std::vector<int>> neighbours(height * width);
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (rows[y][x] == '.') continue;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (dx == 0 && dy == 0) continue;
+                    for (int ny = y + dy, nx = x + dx; ny >= 0 && ny < height && nx >= 0 && nx < width;
+                         ny += dy, nx += dx) {
+                        if (rows[ny][nx] != '.') {
+                            neighbours[y * width + x].push_back(ny * width + nx);
+                            break;
+                        }
+                        if (!line_of_sight) break;
+                    }
+                }
+            }
+        }
+    }
+    return neighbours;
+}
+
+// Runs the seating rules to a fixed point and returns the occupied count, or
+// marks the seats that never settle and returns nothing.
+std::optional<long long> SettleSeats(
+    const std::vector<std::string>& rows, bool line_of_sight, int tolerance, std::vector<bool>& unsettled) {
+    const std::vector<std::vector<int>> neighbours = SeatNeighbours(rows, line_of_sight);
+    const size_t width = rows[0].size();
+    const int kMaxRounds = 100000;
+    std::vector<char> occupied(neighbours.size(), 0);
+    std::vector<char> previous;
+
+    for (int round = 0; round < kMaxRounds; ++round) {
+        std::vector<char> next(occupied);
+        for (size_t seat = 0; seat < neighbours.size(); ++seat) {
+            if (rows[seat / width][seat % width] == '.') continue;
+            int full = 0;
+            for (const int other : neighbours[seat]) full += occupied[other];
+            next[seat] = occupied[seat] ? full < tolerance : full == 0;
+        }
+
+        if (next == occupied) {
+            return std::count(occupied.begin(), occupied.end(), 1);
+        }
+        if (next == previous || round + 1 == kMaxRounds) {
+            for (size_t seat = 0; seat < next.size(); ++seat) {
+                if (next[seat] != occupied[seat]) unsettled[seat] = true;
+            }
+            return std::nullopt;
+        }
+        previous = std::move(occupied);
+        occupied = std::move(next);
+    }
+    return std::nullopt;
+}
+
+}
+
+
+// A seat layout one row per record, as wide as the shipped one. Some random
+// layouts flip back and forth forever, so seats that never settle under
+// either rule are turned into floor until both rules reach a fixed point.
+Answers GenerateSeatLayout(long long size, Random& random, std::ostream& out) {
+    const int kWidth = 98;
+    std::vector<std::string> rows;
+    for (long long y = 0; y < std::max<long long>(size, 1); ++y) {
+        std::string row;
+        for (int x = 0; x < kWidth; ++x) {
+            row += Chance(random, 0.85) ? 'L' : '.';
+        }
+        rows.push_back(std::move(row));
+    }
+
+    Answers answers;
+    for (;;) {
+        std::vector<bool> unsettled(rows.size() * kWidth, false);
+        answers.part_a = SettleSeats(rows, false, 4, unsettled);
+        answers.part_b = SettleSeats(rows, true, 5, unsettled);
+        if (answers.part_a && answers.part_b) break;
+
+        for (size_t seat = 0; seat < unsettled.size(); ++seat) {
+            if (unsettled[seat]) rows[seat / kWidth][seat % kWidth] = '.';
+        }
+    }
+
+    for (const auto& row : rows) {
+        out << row << "\n";
+    }
+    return answers;
+}
+
+// A docking program with one mem write per record, under masks with at most
+// nine floating bits.
+Answers GenerateDockingProgram(long long size, Random& random, std::ostream& out) {
+    const int kBits = 36;
+    std::unordered_map<long long, long long> memory_a;
+    std::unordered_map<long long, long long> memory_b;
+    std::string mask;
+
+    for (long long write = 0; write < size; ++write) {
+        if (write == 0 || Chance(random, 0.2)) {
+            mask = std::string(kBits, '0');
+            for (char& bit : mask) {
+                bit = Chance(random, 0.5) ? '1' : '0';
+            }
+            const int floating = Uniform(random, 0, 9);
+            for (int i = 0; i < floating; ++i) {
+                mask[Uniform(random, 0, kBits - 1)] = 'X';
+            }
+            out << "mask = " << mask << "\n";
+        }
+
+        const long long address = Uniform(random, 0, 65535);
+        const long long value = Uniform(random, 0, (1LL << 30) - 1);
+        out << "mem[" << address << "] = " << value << "\n";
+
+        long long masked_value = value;
+        long long masked_address = address;
+        std::vector<int> floating_bits;
+        for (int i = 0; i < kBits; ++i) {
+            const long long bit = 1LL << (kBits - 1 - i);
+            if (mask[i] == 'X') {
+                floating_bits.push_back(kBits - 1 - i);
+                masked_address &= ~bit;
+            } else if (mask[i] == '1') {
+                masked_value |= bit;
+                masked_address |= bit;
+            } else {
+                masked_value &= ~bit;
+            }
+        }
+        memory_a[address] = masked_value;
+        for (long long choice = 0; choice < (1LL << floating_bits.size()); ++choice) {
+            long long floated = masked_address;
+            for (size_t i = 0; i < floating_bits.size(); ++i) {
+                if ((choice >> i) & 1) {
+                    floated |= 1LL << floating_bits[i];
+                }
+            }
+            memory_b[floated] = value;
+        }
+    }
+
+    long long sum_a = 0;
+    long long sum_b = 0;
+    for (const auto& entry : memory_a) sum_a += entry.second;
+    for (const auto& entry : memory_b) sum_b += entry.second;
+    return {sum_a, sum_b};
+}
+
+// Ticket notes with one nearby ticket per record. Values come in bands of ten
+// and each field accepts a different number of bands, always starting from
+// the first. My ticket puts each field's value in its highest band, so only
+// the widest field fits its column, then only the next widest, and so on.
+Answers GenerateTicketNotes(long long size, Random& random, std::ostream& out) {
+    static const std::vector<std::string> kFields = {
+        "departure location", "departure station", "departure platform", "departure track",
+        "departure date", "departure time", "arrival location", "arrival station",
+        "arrival platform", "arrival track", "class", "duration", "price", "route", "row",
+        "seat", "train", "type", "wagon", "zone"};
+    const int kBand = 10;
+    const int num_fields = kFields.size();
+    const int max_valid = num_fields * kBand;
+
+    // rank[f] is the number of bands field f accepts; column[f] is where it sits on tickets.
+    std::vector<int> rank(num_fields);
+    std::vector<int> column(num_fields);
+    for (int f = 0; f < num_fields; ++f) rank[f] = column[f] = f;
+    std::shuffle(rank.begin(), rank.end(), random);
+    std::shuffle(column.begin(), column.end(), random);
+
+    for (int f = 0; f < num_fields; ++f) {
+        const int top = (rank[f] + 1) * kBand;
+        const int gap = Uniform(random, 1, top - 1);
+        out << kFields[f] << ": 1-" << gap << " or " << gap + 1 << "-" << top << "\n";
+    }
+
+    // A value for the field, in its own band on my ticket and any band it accepts elsewhere.
+    auto value_for = [&](int f, bool own_band) {
+        const int band = own_band ? rank[f] : Uniform(random, 0, rank[f]);
+        return static_cast<int>(Uniform(random, band * kBand + 1, (band + 1) * kBand));
+    };
+    auto write_ticket = [&out](const std::vector<int>& values) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            out << (i == 0 ? "" : ",") << values[i];
+        }
+        out << "\n";
+    };
+
+    std::vector<int> mine(num_fields);
+    long long departure_product = 1;
+    for (int f = 0; f < num_fields; ++f) {
+        mine[column[f]] = value_for(f, true);
+        if (kFields[f].rfind("departure", 0) == 0) {
+            departure_product *= mine[column[f]];
+        }
+    }
+    out << "\nyour ticket:\n";
+    write_ticket(mine);
+
+    out << "\nnearby tickets:\n";
+    long long error_rate = 0;
+    for (long long ticket = 0; ticket < size; ++ticket) {
+        std::vector<int> values(num_fields);
+        for (int f = 0; f < num_fields; ++f) {
+            values[column[f]] = value_for(f, false);
+        }
+        if (Chance(random, 0.25)) {
+            const int invalid = Uniform(random, max_valid + 1, 999);
+            values[Uniform(random, 0, num_fields - 1)] = invalid;
+            error_rate += invalid;
+        }
+        write_ticket(values);
+    }
+
+    return {error_rate, departure_product};
+}
+
+
+namespace {
+
+struct Expression {
+    std::string text;
+    // Values with equal precedence and with addition first. Doubles are exact
+    // here because anything that would need more than 53 bits is rejected.
+    double left_to_right;
+    double addition_first;
+};
+
+Expression GenerateExpressionOfDepth(Random& random, int depth) {
+    const int operands = Uniform(random, 2, depth == 0 ? 6 : 4);
+    Expression result{"", 0, 0};
+    double running_sum = 0;
+    double product = 1;
+
+    for (int i = 0; i < operands; ++i) {
+        Expression operand;
+        if (depth < 2 && Chance(random, 0.3)) {
+            operand = GenerateExpressionOfDepth(random, depth + 1);
+            operand.text = "(" + operand.text + ")";
+        } else {
+            const int digit = Uniform(random, 1, 9);
+            operand = {std::to_string(digit), static_cast<double>(digit), static_cast<double>(digit)};
+        }
+
+        if (i == 0) {
+            result = operand;
+            running_sum = operand.addition_first;
+        } else if (Chance(random, 0.5)) {
+            result.text += " + " + operand.text;
+            result.left_to_right += operand.left_to_right;
+            running_sum += operand.addition_first;
+        } else {
+            result.text += " * " + operand.text;
+            result.left_to_right *= operand.left_to_right;
+            product *= running_sum;
+            running_sum = operand.addition_first;
+        }
+    }
+
+    result.addition_first = product * running_sum;
+    return result;
+}
+
+}
+
+
+// Homework expressions, one per record.
+Answers GenerateExpressions(long long size, Random& random, std::ostream& out) {
+    const double kMaxValue = 1e12;
+    long long sum_a = 0;
+    long long sum_b = 0;
+
+    for (long long i = 0; i < size; ++i) {
+        Expression expression;
+        do {
+            expression = GenerateExpressionOfDepth(random, 0);
+        } while (expression.left_to_right > kMaxValue || expression.addition_first > kMaxValue);
+
+        out << expression.text << "\n";
+        sum_a += static_cast<long long>(expression.left_to_right);
+        sum_b += static_cast<long long>(expression.addition_first);
+    }
+
+    return {sum_a, sum_b};
+}
+
+
+namespace {
+
+// A rule is a letter or a set of alternatives, each a pair of rules from the
+// level below. Every string matching a rule on level k has length 2^k, which
+// keeps matching unambiguous.
+struct GrammarRule {
+    char letter = 0;
+    std::vector<std::pair<int, int>> alternatives;
+};
+
+bool MatchesGrammarRule(const std::vector<GrammarRule>& rules, int rule, std::string_view text) {
+    if (rules[rule].letter) {
+        return text.size() == 1 && text[0] == rules[rule].letter;
+    }
+    const std::string_view left = text.substr(0, text.size() / 2);
+    const std::string_view right = text.substr(text.size() / 2);
+    return std::any_of(
+        rules[rule].alternatives.begin(), rules[rule].alternatives.end(),
+        [&](const std::pair<int, int>& pair) {
+            return MatchesGrammarRule(rules, pair.first, left) && MatchesGrammarRule(rules, pair.second, right);
+        });
+}
+
+void ExpandGrammarRule(const std::vector<GrammarRule>& rules, int rule, Random& random, std::string& out) {
+    if (rules[rule].letter) {
+        out += rules[rule].letter;
+        return;
+    }
+    const auto& pair = rules[rule].alternatives[Uniform(random, 0, rules[rule].alternatives.size() - 1)];
+    ExpandGrammarRule(rules, pair.first, random, out);
+    ExpandGrammarRule(rules, pair.second, random, out);
+}
+
+}
+
+
+// A grammar of about a hundred rules followed by one message per record,
+// about half of which match rule 0.
+Answers GenerateGrammarAndMessages(long long size, Random& random, std::ostream& out) {
+    const int kLevels = 5;
+    const int kRulesPerLevel = 24;
+
+    // Rule 0 is the single rule on the top level.
+    std::vector<GrammarRule> rules(1);
+    std::vector<int> level = {static_cast<int>(rules.size())};
+    rules.push_back({'a', {}});
+    rules.push_back({'b', {}});
+    level.push_back(rules.size());
+    for (int depth = 1; depth < kLevels; ++depth) {
+        const int below_start = level[level.size() - 2];
+        const int below_end = level.back();
+        for (int i = 0; i < kRulesPerLevel; ++i) {
+            GrammarRule rule;
+            const int alternatives = Uniform(random, 1, 2);
+            for (int a = 0; a < alternatives; ++a) {
+                rule.alternatives.push_back(
+                    {Uniform(random, below_start, below_end - 1), Uniform(random, below_start, below_end - 1)});
+            }
+            rules.push_back(rule);
+        }
+        level.push_back(rules.size());
+    }
+    rules[0].alternatives.push_back(
+        {Uniform(random, level[level.size() - 2], level.back() - 1),
+         Uniform(random, level[level.size() - 2], level.back() - 1)});
+
+    // Shuffle every id but 0.
+    std::vector<int> ids(rules.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = i;
+    std::shuffle(ids.begin() + 1, ids.end(), random);
+
+    std::vector<int> order(rules.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), random);
+    for (const int rule : order) {
+        out << ids[rule] << ":";
+        if (rules[rule].letter) {
+            out << " \"" << rules[rule].letter << "\"";
+        }
+        for (size_t a = 0; a < rules[rule].alternatives.size(); ++a) {
+            out << (a == 0 ? "" : " |") << " " << ids[rules[rule].alternatives[a].first]
+                << " " << ids[rules[rule].alternatives[a].second];
+        }
+        out << "\n";
+    }
+    out << "\n";
+
+    const int message_length = 1 << kLevels;
+    long long matches = 0;
+    for (long long i = 0; i < size; ++i) {
+        std::string message;
+        if (Chance(random, 0.5)) {
+            ExpandGrammarRule(rules, 0, random, message);
+        } else {
+            for (int c = 0; c < message_length; ++c) {
+                message += Chance(random, 0.5) ? 'a' : 'b';
+            }
+        }
+        matches += MatchesGrammarRule(rules, 0, message);
+        out << message << "\n";
+    }
+
+    return {matches, std::nullopt};
+}
+
+
+const std::map<std::string, Generator> kGenerators = {
+    {"2020-02", GeneratePasswordPolicies},
+    {"2020-03", GenerateTreeGrid},
+    {"2020-04", GeneratePassports},
+    {"2020-05", GenerateBoardingPasses},
+    {"2020-06", GenerateCustomsForms},
+    {"2020-07", GenerateBagRules},
+    {"2020-08", GenerateHandheldProgram},
+    {"2020-11", GenerateSeatLayout},
+    {"2020-14", GenerateDockingProgram},
+    {"2020-16", GenerateTicketNotes},
+    {"2020-18", GenerateExpressions},
+    {"2020-19", GenerateGrammarAndMessages},
+};
+
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string_view> positional;
+    Random::result_type seed = 2020;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.rfind("--seed=", 0) == 0) {
+            seed = std::stoull(std::string(arg.substr(7)));
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    const auto generator = positional.size() == 2 ? kGenerators.find(std::string(positional[0])) : kGenerators.end();
+    if (generator == kGenerators.end()) {
+        std::cerr << "Usage: " << argv[0] << " <day> <size> [--seed=<n>]" << std::endl << "Days:";
+        for (const auto& entry : kGenerators) {
+            std::cerr << " " << entry.first;
+        }
+        std::cerr << std::endl;
+        return 1;
+    }
+
+    std::ios_base::sync_with_stdio(false);
+    Random random(seed);
+    const Answers answers = generator->second(std::stoll(std::string(positional[1])), random, std::cout);
+    std::cout.flush();
+
+    if (answers.part_a) {
+        std::cerr << "Part a: " << *answers.part_a << std::endl;
+    }
+    if (answers.part_b) {
+        std::cerr << "Part b: " << *answers.part_b << std::endl;
+    }
+    if (!answers.solver_flags.empty()) {
+        std::cerr << "Solver flags: " << answers.solver_flags << std::endl;
+    }
+}
@@ -0,0 +1,16 @@
+# Merges the raw profiles Clang writes during training into the single file
+# that -fprofile-use reads.
+#
+#   cmake -DLLVM_PROFDATA=<path> -DPROFILE_DIR=<dir> -P merge_profiles.cmake
+
+file(GLOB raw_profiles "${PROFILE_DIR}/*.profraw")
+if(NOT raw_profiles)
+  message(FATAL_ERROR "No raw profiles found in ${PROFILE_DIR}; did training run?")
+endif()
+
+execute_process(
+  COMMAND "${LLVM_PROFDATA}" merge -o "${PROFILE_DIR}/merged.profdata" ${raw_profiles}
+  RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "llvm-profdata failed to merge the profiles")
+endif()
@@ -0,0 +1,6 @@
+#include "../common/microbench.h"
+
+
+int main(int argc, char* argv[]) {
+    return RunMicrobenchmarks(argc, argv);
+}
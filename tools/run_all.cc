@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../common/thread_pool.h"
+#include "../2020-01/expense_report.h"
+#include "../2020-02/password_policy.h"
+#include "../2020-03/toboggan_map.h"
+#include "../2020-04/passport_validator.h"
+#include "../2020-05/boarding_pass.h"
+#include "../2020-06/customs_forms.h"
+#include "../2020-07/luggage_graph.h"
+#include "../2020-08/handheld_console.h"
+#include "../2020-09/xmas_cipher.h"
+#include "../2020-10/joltage_adaptors.h"
+#include "../2020-11/seating_system.h"
+#include "../2020-12/ferry_navigation.h"
+#include "../2020-13/shuttle_buses.h"
+#include "../2020-14/docking_program.h"
+#include "../2020-15/memory_game.h"
+#include "../2020-16/ticket_translation.h"
+#include "../2020-17/conway_cubes.h"
+#include "../2020-18/operation_order.h"
+#include "../2020-19/monster_messages.h"
+
+
+// Runs every 2020 solver in one process, scheduling the days across a thread
+// pool, and prints each answer with how long it took. Solvers that can split
+// their own work (2020-17b) do so on the same pool.
+
+
+struct Solver {
+    std::string name;
+    // Relative to the data directory.
+    std::string input;
+    // Left out unless --include-slow is passed.
+    bool slow;
+    std::function<std::string(const std::string& input_path, ThreadPool* pool)> solve;
+};
+
+struct SolverResult {
+    std::string answer;
+    bool failed = false;
+    double wall_ms = 0;
+};
+
+
+template <typename T>
+std::string ToString(const T& value) {
+    std::stringstream result;
+    result << value;
+    return result.str();
+}
+
+const std::vector<Solver> kSolvers = {
+    {"2020-01a", "2020-01/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day01::FindPairProduct(day01::ParseNumberListFile(input), day01::kExpenseTarget));
+    }},
+    {"2020-01b", "2020-01/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day01::FindTripleProduct(day01::ParseNumberListFile(input), day01::kExpenseTarget));
+    }},
+    {"2020-02a", "2020-02/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day02::CountPasswordsValidByOccurrences(day02::ParsePasswordDatabaseFile(input)));
+    }},
+    {"2020-02b", "2020-02/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day02::CountPasswordsValidByPosition(day02::ParsePasswordDatabaseFile(input)));
+    }},
+    {"2020-03a", "2020-03/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day03::CountTreeHits(day03::LoadGridFromFile(input), 3, 1));
+    }},
+    {"2020-03b", "2020-03/data", false, [](const std::string& input, ThreadPool*) {
+        const day03::Slope slopes[] = {{1, 1}, {3, 1}, {5, 1}, {7, 1}, {1, 2}};
+        return ToString(day03::ReportTreeHits(day03::LoadGridFromFile(input), slopes, std::size(slopes)).product);
+    }},
+    {"2020-04a", "2020-04/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day04::CountPassportsFile(input).complete);
+    }},
+    {"2020-04b", "2020-04/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day04::CountPassportsFile(input).valid);
+    }},
+    {"2020-05a", "2020-05/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day05::SummariseSeatIdsFile(input).highest());
+    }},
+    {"2020-05b", "2020-05/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day05::SummariseSeatIdsFile(input).MissingSeatId().value());
+    }},
+    {"2020-06a", "2020-06/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day06::GetSumOfAnsweredQuestions(day06::ParseCustomsDeclarationsFile(input)));
+    }},
+    {"2020-06b", "2020-06/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day06::GetSumOfUnanimouslyAnsweredQuestions(day06::ParseCustomsDeclarationsFile(input)));
+    }},
+    {"2020-07a", "2020-07/data", false, [](const std::string& input, ThreadPool*) {
+        auto graph = day07::ParseLuggageGraphFile(input);
+        return ToString(day07::CountPossibleContainers("shiny gold", graph));
+    }},
+    {"2020-07b", "2020-07/data", false, [](const std::string& input, ThreadPool*) {
+        auto graph = day07::ParseLuggageGraphFile(input);
+        return ToString(day07::CountContainedBags("shiny gold", graph));
+    }},
+    {"2020-08a", "2020-08/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day08::FindAccumulatorAtInfiniteLoop(day08::ParseInstructionsFile(input)));
+    }},
+    {"2020-08b", "2020-08/data", false, [](const std::string& input, ThreadPool*) {
+        const auto programs = day08::GetPossiblePrograms(day08::ParseInstructionsFile(input));
+        return ToString(day08::FindReturnValueOfSuccessfulProgram(programs));
+    }},
+    {"2020-09a", "2020-09/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day09::FindIncorrectNumber(day09::ParseXmasNumbersFile(input), 25));
+    }},
+    {"2020-09b", "2020-09/data", false, [](const std::string& input, ThreadPool*) {
+        const auto numbers = day09::ParseXmasNumbersFile(input);
+        return ToString(day09::ComputeEncryptionWeakness(numbers, day09::FindIncorrectNumber(numbers, 25)));
+    }},
+    {"2020-10a", "2020-10/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day10::ComputeDifferenceProduct(day10::ParseAdaptorJoltagesFile(input)));
+    }},
+    {"2020-10b", "2020-10/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day10::FindNumberOfAdaptations(day10::ParseAdaptorJoltagesFile(input)));
+    }},
+    {"2020-11a", "2020-11/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day11::SimulateToCompletionAndCountUnoccupiedSeats(
+            day11::ParseGridFile(input), day11::kAdjacentSeatRules));
+    }},
+    {"2020-11b", "2020-11/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day11::SimulateToCompletionAndCountUnoccupiedSeats(
+            day11::ParseGridFile(input), day11::kVisibleSeatRules));
+    }},
+    {"2020-12a", "2020-12/data", false, [](const std::string& input, ThreadPool*) {
+        const auto [x, y] = day12::ExecuteInstructions(day12::ParseInstructionsFile(input));
+        return ToString(std::abs(x) + std::abs(y));
+    }},
+    {"2020-12b", "2020-12/data", false, [](const std::string& input, ThreadPool*) {
+        const auto [x, y] = day12::ExecuteWaypointInstructions(day12::ParseInstructionsFile(input));
+        return ToString(std::abs(x) + std::abs(y));
+    }},
+    {"2020-13a", "2020-13/data", false, [](const std::string& input, ThreadPool*) {
+        const auto [depart_time, buses] = day13::ParseBusesFile(input);
+        const auto [bus_id, time_to_depart] = day13::FindBestBusIdAndTimeToDeparture(depart_time, buses);
+        return ToString(bus_id * time_to_depart);
+    }},
+    // Searches timestamps one at a time, which takes far too long on the real input.
+    {"2020-13b", "2020-13/data", true, [](const std::string& input, ThreadPool*) {
+        return ToString(day13::FindEarliestMagicTimestamp(day13::ParseBusesFile(input).buses));
+    }},
+    {"2020-14a", "2020-14/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day14::ExecuteAndComputeMemorySum(day14::ParseInstructionsFile(input)));
+    }},
+    {"2020-14b", "2020-14/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day14::ExecuteWithFloatingAddressesAndComputeMemorySum(day14::ParseInstructionsFile(input)));
+    }},
+    {"2020-15a", "2020-15/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day15::FindNthNumber(day15::ParseNumbersFile(input), 2020));
+    }},
+    // Each turn depends on the one before, so this can't be split up.
+    {"2020-15b", "2020-15/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day15::FindNthNumber(day15::ParseNumbersFile(input), 30000000));
+    }},
+    {"2020-16a", "2020-16/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day16::ComputeScanErrorRate(day16::ParseProblemDataFile(input)));
+    }},
+    {"2020-16b", "2020-16/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day16::MultiplyDepartureFields(day16::ParseProblemDataFile(input)));
+    }},
+    {"2020-17a", "2020-17/data", false, [](const std::string& input, ThreadPool*) {
+        return ToString(day17::EvaluateSixCyclesAndCountActiveCubes(day17::ParseInitialCubeFile(input)));
+    }},
+    {"2020-17b", "2020-17/data", false, [](const std::string& input, ThreadPool* pool) {
+        return ToString(day17::EvaluateSixCyclesAndCountActiveCubes(day17::ParseInitialHypercubeFile(input), pool));
+    }},
+    {"2020-18a", "2020-18/data", false, [](const std::string& input, ThreadPool*) {
+        const auto results = day18::EvaluateMultiplePrograms(day18::LexFile(input), day18::Precedence::EQUAL);
+        return ToString(std::accumulate(results.begin(), results.end(), 0LL));
+    }},
+    {"2020-18b", "2020-18/data", false, [](const std::string& input, ThreadPool*) {
+        const auto results = day18::EvaluateMultiplePrograms(day18::LexFile(input), day18::Precedence::ADDITION_FIRST);
+        return ToString(std::accumulate(results.begin(), results.end(), 0LL));
+    }},
+    {"2020-19a", "2020-19/data", false, [](const std::string& input, ThreadPool*) {
+        const auto problem_data = day19::ParseProblemDataFile(input);
+        return ToString(day19::CountMatches(problem_data.examples, problem_data.rules));
+    }},
+};
+
+
+SolverResult Run(const Solver& solver, const std::string& data_dir, ThreadPool* pool) {
+    SolverResult result;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        result.answer = solver.solve(data_dir + "/" + solver.input, pool);
+    } catch (const std::exception& e) {
+        result.answer = e.what();
+        result.failed = true;
+    }
+    result.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    std::string data_dir = AOC_SOURCE_DIR;
+    std::string filter;
+    unsigned threads = std::thread::hardware_concurrency();
+    bool include_slow = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.rfind("--data-dir=", 0) == 0) {
+            data_dir = arg.substr(11);
+        } else if (arg.rfind("--filter=", 0) == 0) {
+            filter = arg.substr(9);
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            threads = std::stoi(std::string(arg.substr(10)));
+        } else if (arg == "--include-slow") {
+            include_slow = true;
+        } else {
+            std::cout << "Usage: " << argv[0]
+                      << " [--data-dir=<dir>] [--filter=<name>] [--threads=<n>] [--include-slow]";
+            return 1;
+        }
+    }
+
+    threads = std::max(1u, threads);
+
+    std::vector<const Solver*> selected;
+    for (const Solver& solver : kSolvers) {
+        if ((include_slow || !solver.slow) && solver.name.find(filter) != std::string::npos) {
+            selected.push_back(&solver);
+        }
+    }
+
+    std::vector<SolverResult> results(selected.size());
+    const auto start = std::chrono::steady_clock::now();
+    {
+        // Each solver is a task of its own, and the main thread just waits, so
+        // no solver's timing includes another's.
+        ThreadPool pool(threads);
+        CountdownLatch finished(selected.size());
+        for (size_t i = 0; i < selected.size(); ++i) {
+            pool.Submit([&, i]() {
+                results[i] = Run(*selected[i], data_dir, &pool);
+                finished.CountDown();
+            });
+        }
+        finished.Wait();
+    }
+    const double total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    bool all_passed = true;
+    double summed_ms = 0;
+    for (size_t i = 0; i < selected.size(); ++i) {
+        all_passed = all_passed && !results[i].failed;
+        summed_ms += results[i].wall_ms;
+        std::cout << std::left << std::setw(12) << selected[i]->name
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(12) << results[i].wall_ms << " ms  "
+                  << (results[i].failed ? "FAILED: " : "") << results[i].answer << std::endl;
+    }
+    std::cout << "Ran " << selected.size() << " solvers on " << threads << " threads in "
+              << std::fixed << std::setprecision(2) << total_ms << " ms (" << summed_ms << " ms summed)." << std::endl;
+
+    return all_passed ? 0 : 1;
+}